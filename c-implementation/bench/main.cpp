@@ -0,0 +1,353 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+#include "models.h"
+
+/*
+    Microbenchmarks of the operators and of full generations of the examples, measured
+    for several population sizes and genome lengths. Results are printed as CSV or JSON,
+    so they can be compared between releases.
+*/
+
+#define REPETITIONS 5 // Median of these many batches is reported
+#define POOL_JOBS 64 // Problems of each solver pool batch
+
+enum class BENCHFORMAT {CSV, JSON};
+
+struct BenchResult {
+    std::string name;
+    unsigned int population;
+    unsigned int genome; // Bits or variables of the chromosomes, or objectives for the dominance test
+    unsigned long iterations; // Operations of each batch
+    double nsPerOp;
+};
+
+class Bench {
+    public:
+        Bench(double minTime, const std::string &filter) : minTime(minTime), filter(filter) {}
+
+        inline bool enabled(const std::string &name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+
+        template<typename Op>
+        void measure(const std::string &name, unsigned int population, unsigned int genome, Op op) {
+            measure(name, population, genome, []{}, op, false);
+        }
+
+        // The preparation is run before every operation and is not timed
+        template<typename Prepare, typename Op>
+        void measure(const std::string &name, unsigned int population, unsigned int genome, Prepare prepare, Op op, bool timeEach = true) {
+            if(!enabled(name))
+                return;
+            unsigned long n = 1; // Batches of at least minTime / REPETITIONS
+            while(batch(prepare, op, n, timeEach) < minTime * 1e6 / REPETITIONS && n < (1UL << 40))
+                n *= 2;
+            std::vector<double> times;
+            for (int r = 0; r < REPETITIONS; r++)
+                times.push_back(batch(prepare, op, n, timeEach) / n);
+            std::sort(times.begin(), times.end());
+            results.push_back({name, population, genome, n, times[REPETITIONS / 2]});
+            std::cerr << name << " (population " << population << ", genome " << genome << "): " << times[REPETITIONS / 2] << " ns" << std::endl;
+        }
+
+        void print(std::ostream &os, BENCHFORMAT format, uint64_t seed) const {
+            if(format == BENCHFORMAT::CSV){
+                os << "benchmark,population,genome,iterations,ns_per_op" << std::endl;
+                for(const BenchResult &r : results)
+                    os << r.name << "," << r.population << "," << r.genome << "," << r.iterations << "," << r.nsPerOp << std::endl;
+                return;
+            }
+            os << "{" << std::endl << "  \"seed\": " << seed << "," << std::endl << "  \"benchmarks\": [" << std::endl;
+            for (unsigned int i = 0; i < results.size(); i++) {
+                const BenchResult &r = results[i];
+                os << "    {\"benchmark\": \"" << r.name << "\", \"population\": " << r.population << ", \"genome\": " << r.genome
+                    << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.nsPerOp << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+            }
+            os << "  ]" << std::endl << "}" << std::endl;
+        }
+
+    private:
+        double minTime; // Milliseconds of each measurement
+        std::string filter; // Only benchmarks whose name contains it
+        std::vector<BenchResult> results;
+
+        template<typename Prepare, typename Op>
+        static double batch(Prepare &prepare, Op &op, unsigned long n, bool timeEach) { // Nanoseconds
+            using clock = std::chrono::steady_clock;
+            if(!timeEach){
+                auto begin = clock::now();
+                for (unsigned long i = 0; i < n; i++)
+                    op();
+                return std::chrono::duration<double, std::nano>(clock::now() - begin).count();
+            }
+            double total = 0.0;
+            for (unsigned long i = 0; i < n; i++) {
+                prepare();
+                auto begin = clock::now();
+                op();
+                total += std::chrono::duration<double, std::nano>(clock::now() - begin).count();
+            }
+            return total;
+        }
+};
+
+static const unsigned int populations[] = {64, 256, 1024, 4096};
+static const unsigned int lengths[] = {32, 256, 2048, 16384};
+static volatile unsigned long sink; // Keeps the results of the measured functions
+
+GAConfig* benchConfig(unsigned int population, uint64_t seed, SELECTION selection = SELECTION::ROULETTE) {
+    GAConfig *config = new GAConfig();
+    config->populationSize = population;
+    config->maxGenerations = 1000000000; // Runs never stop while measured
+    config->stagnationWindow = 1.0;
+    config->timeout = 1000000000;
+    config->selection = selection;
+    config->seed = seed;
+    return config;
+}
+
+std::vector<unsigned int>* subsetInstance(unsigned int length, unsigned int &target) {
+    // Same distribution as the subsetsum example (20 elements and a target from 100 to 200)
+    Uniform uniform;
+    std::vector<unsigned int> *set = new std::vector<unsigned int>();
+    for (unsigned int i = 0; i < length; i++)
+        set->push_back((unsigned int) uniform.random(1, 100));
+    target = (unsigned int) uniform.random(5.0 * length, 10.0 * length);
+    return set;
+}
+
+void benchOperators(Bench &bench, uint64_t seed) {
+    for(unsigned int length : lengths) {
+        unsigned int target;
+        std::vector<unsigned int> *set = subsetInstance(length, target);
+        SubsetSumFitness fitness(set, target);
+        Chromosome *a = fitness.generateChromosome();
+        Chromosome *b = fitness.generateChromosome();
+        bench.measure("mutate", 1, length, [a]{ a->mutate(); });
+        bench.measure("crossover", 1, length, [a, b]{ a->crossover(b); });
+        delete a;
+        delete b;
+        delete set;
+    }
+
+    for(unsigned int length : lengths) { // Real variables in [0, 1], mutated with probability 1/n
+        std::vector<double> lower(length, 0.0), upper(length, 1.0);
+        RealVectorChromosome a(&lower, &upper, 1.0/(double)length);
+        RealVectorChromosome b(&lower, &upper, 1.0/(double)length);
+        bench.measure("mutate_real_vector", 1, length, [&a]{ a.mutate(); });
+        bench.measure("crossover_real_vector", 1, length, [&a, &b]{ a.crossover(&b); });
+    }
+
+    const PERMCROSSOVER permCrossovers[] = {PERMCROSSOVER::OX, PERMCROSSOVER::PMX, PERMCROSSOVER::ERX};
+    const char *permNames[] = {"crossover_ox", "crossover_pmx", "crossover_erx"};
+    for(unsigned int length : lengths) { // Permutations of the elements, one move per mutation on average
+        for (unsigned int c = 0; c < 3; c++) {
+            PermutationChromosome a(length, 1.0/(double)length, permCrossovers[c]);
+            PermutationChromosome b(length, 1.0/(double)length, permCrossovers[c]);
+            if(c == 0)
+                bench.measure("mutate_inversion", 1, length, [&a]{ a.mutate(); a.evaluated(); });
+            bench.measure(permNames[c], 1, length, [&a, &b]{ a.crossover(&b); });
+        }
+    }
+
+    const SELECTION methods[] = {SELECTION::ROULETTE, SELECTION::TOURNAMENT, SELECTION::RANK};
+    const char *names[] = {"selection_roulette", "selection_tournament", "selection_rank"};
+    for(unsigned int population : populations) {
+        unsigned int target;
+        std::vector<unsigned int> *set = subsetInstance(256, target);
+        for (unsigned int s = 0; s < 3; s++) {
+            GAConfig *config = benchConfig(population, seed, methods[s]);
+            BenchGA *ga = new BenchGA(new SubsetSumFitness(set, target), config);
+            bench.measure(names[s], population, 256, [ga]{ ga->selection(); });
+            if(s == 0)
+                bench.measure("sort_population", population, 256, [ga]{ ga->shuffle(); }, [ga]{ ga->sortPopulation(); });
+            delete ga;
+            delete config;
+        }
+        delete set;
+    }
+}
+
+void benchMultiObjective(Bench &bench, uint64_t seed) {
+    for(unsigned int population : populations) {
+        GAConfig *config = benchConfig(population, seed);
+        BenchMOGA *moga = new BenchMOGA(new TwoObjectiveFitness(), config);
+        moga->start(); // Sizes the ranks of the population
+        bench.measure("moga_sort_population", population, 2, [moga]{ moga->sortPopulation(); });
+        moga->rank();
+        bench.measure("crowding_distance", population, 2, [moga]{ moga->crowding(); });
+        delete moga;
+        delete config;
+    }
+
+    GAConfig *config = benchConfig(2, seed);
+    BenchMOGA *moga = new BenchMOGA(new TwoObjectiveFitness(), config);
+    for(unsigned int m : {2u, 3u, 5u, 10u}) {
+        RealCh a, b;
+        Uniform uniform;
+        for (unsigned int k = 0; k < m; k++) { // Neither one dominates in most pairs
+            a.objectives.push_back(uniform.random());
+            b.objectives.push_back(uniform.random());
+        }
+        bench.measure("dominates", 1, m, [moga, &a, &b]{ sink = sink + moga->dominates(a, b); });
+    }
+    delete moga;
+    delete config;
+}
+
+void benchGenerations(Bench &bench, uint64_t seed) {
+    for(unsigned int population : populations) {
+        GAConfig *config = benchConfig(population, seed);
+        GeneticAlgorithm *ga = new GeneticAlgorithm(new QuadraticFitness(), config);
+        ga->start();
+        bench.measure("generation_quadratic", population, FLOAT_BITS, [ga]{ ga->step(); });
+        delete ga;
+        delete config;
+    }
+
+    for(unsigned int population : populations) {
+        GAConfig *config = benchConfig(population, seed);
+        GeneticAlgorithmT<QuadraticValue, QuadraticFitnessT> *ga = new GeneticAlgorithmT<QuadraticValue, QuadraticFitnessT>(QuadraticFitnessT(), config);
+        ga->start();
+        bench.measure("generation_quadratic_template", population, FLOAT_BITS, [ga]{ ga->step(); });
+        delete ga;
+        delete config;
+    }
+
+    for(unsigned int population : populations) {
+        for(unsigned int length : lengths) {
+            if(population > 256 && length > 256) // Both sizes are scaled, but not together
+                continue;
+            unsigned int target;
+            std::vector<unsigned int> *set = subsetInstance(length, target);
+            GAConfig *config = benchConfig(population, seed);
+            GeneticAlgorithm *ga = new GeneticAlgorithm(new SubsetSumFitness(set, target), config);
+            ga->start();
+            bench.measure("generation_subsetsum", population, length, [ga]{ ga->step(); });
+            delete ga;
+            delete config;
+            delete set;
+        }
+    }
+
+    for(unsigned int population : populations) {
+        GAConfig *config = benchConfig(population, seed);
+        MultiObjectiveGA *moga = new MultiObjectiveGA(new TwoObjectiveFitness(), config);
+        moga->start();
+        bench.measure("generation_moga", population, 2, [moga]{ moga->step(); });
+        delete moga;
+        delete config;
+    }
+}
+
+void benchSolverPool(Bench &bench, uint64_t seed) {
+    // Batches of small subset sum problems, solved with a new algorithm for each problem, with
+    // one algorithm reset for each problem, or with the reused algorithms of a pool. Each operation
+    // is a batch of POOL_JOBS problems, short enough for the setup of the runs to be measured
+    const unsigned int jobs = POOL_JOBS, length = 20, population = 32;
+    unsigned int target;
+    std::vector<unsigned int> *set = subsetInstance(length, target);
+    std::vector<GAConfig*> configs;
+    for (unsigned int j = 0; j < jobs; j++) {
+        GAConfig *config = benchConfig(population, seed + j);
+        config->maxGenerations = 5;
+        config->threads = 1;
+        config->printLevel = 0;
+        configs.push_back(config);
+    }
+    bench.measure("solver_sequential_batch", population, length, [set, target, &configs]{
+        for(GAConfig *config : configs) {
+            GeneticAlgorithm *ga = new GeneticAlgorithm(new SubsetSumFitness(set, target), config);
+            sink = sink + (unsigned long) ga->run().best->fitness;
+            delete ga;
+        }
+    });
+    bench.measure("solver_reset_batch", population, length, [set, target, &configs]{
+        GeneticAlgorithm *ga = nullptr;
+        for(GAConfig *config : configs) {
+            if(ga == nullptr)
+                ga = new GeneticAlgorithm(new SubsetSumFitness(set, target), config);
+            else
+                ga->reset(new SubsetSumFitness(set, target), config);
+            sink = sink + (unsigned long) ga->run().best->fitness;
+        }
+        delete ga;
+    });
+    SolverPool *pool = new SolverPool(0);
+    bench.measure("solver_pool_batch", population, length, [pool, set, target, &configs]{
+        for(GAConfig *config : configs)
+            pool->submit(new SubsetSumFitness(set, target), config);
+        SolverResult result;
+        while(pool->next(result)) {
+            sink = sink + (unsigned long) result.results.best->fitness;
+            delete result.results.best;
+            delete result.fitnessFunction;
+        }
+    });
+    delete pool;
+    for(GAConfig *config : configs)
+        delete config;
+    delete set;
+}
+
+void printUsage() {
+    std::cerr << "Usage: benchmark [-f csv|json] [-o file] [-t ms] [-b name] [-r seed]" << std::endl;
+    std::cerr << "   -f  Output format, CSV by default" << std::endl;
+    std::cerr << "   -o  Output file, standard output by default" << std::endl;
+    std::cerr << "   -t  Milliseconds of each measurement, 100 by default" << std::endl;
+    std::cerr << "   -b  Only run the benchmarks whose name contains this text" << std::endl;
+    std::cerr << "   -r  Random seed" << std::endl;
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BENCHFORMAT format = BENCHFORMAT::CSV;
+    std::string output, filter;
+    double minTime = 100.0;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            printUsage();
+        } else if (strcmp(argv[i], "-f") == 0) {
+            if (strcmp(argv[i + 1], "json") == 0)
+                format = BENCHFORMAT::JSON;
+            else if (strcmp(argv[i + 1], "csv") != 0)
+                printUsage();
+            i++;
+        } else if (strcmp(argv[i], "-o") == 0) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0) {
+            minTime = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "-r") == 0) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            printUsage();
+        }
+    }
+
+    Uniform::setSeed(seed);
+    Bench bench(minTime, filter);
+    benchOperators(bench, seed);
+    benchMultiObjective(bench, seed);
+    benchGenerations(bench, seed);
+    benchSolverPool(bench, seed);
+
+    if(output.empty()){
+        bench.print(std::cout, format, seed);
+    }else{
+        std::ofstream file(output);
+        if(!file.is_open()){
+            std::cerr << "Cannot write " << output << std::endl;
+            return 1;
+        }
+        bench.print(file, format, seed);
+    }
+    return 0;
+}
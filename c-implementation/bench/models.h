@@ -0,0 +1,262 @@
+#ifndef BENCH_MODELS_H
+#define BENCH_MODELS_H
+
+#include <vector>
+#include <cstring>
+#include <math.h>
+
+#include "../src/lib/ga.h"
+#include "../src/lib/moga.h"
+#include "../src/lib/bitstring_chromosome.h"
+#include "../src/lib/ga_template.h"
+#include "../src/lib/fixed_bitstring.h"
+#include "../src/lib/real_vector_chromosome.h"
+#include "../src/lib/permutation_chromosome.h"
+#include "../src/lib/solver_pool.h"
+
+/*
+    Models of the examples (quadratic, subsetsum and moga), with the genome length as a
+    parameter so the operators can be measured with longer chromosomes.
+*/
+
+#define FLOAT_BITS 32
+
+class QuadraticCh : public BitStringChromosome { // Float value between -100 and 100 (quadratic example)
+    public:
+        QuadraticCh(double mutProb) : BitStringChromosome(FLOAT_BITS, mutProb) {
+            const float value = (float) uniform.random(-100.0, 100.0);
+            uint32_t binary;
+            std::memcpy(&binary, &value, sizeof(binary));
+            setBits(0, FLOAT_BITS, binary);
+        }
+
+        std::string getName() const override { return "Binary float value"; }
+
+        float getPhenotype() const {
+            uint32_t binary = (uint32_t) getBits(0, FLOAT_BITS);
+            float value;
+            std::memcpy(&value, &binary, sizeof(value));
+            return value;
+        }
+
+        void printPhenotype() const override { std::cout << "Phenotype: " << getPhenotype() << std::endl; }
+};
+
+class QuadraticFitness : public Fitness { // f(x) = -x^2 + 2x + 1
+    public:
+        std::string getName() const override { return "f(x) = -x^2 + 2x + 1"; }
+
+        void evaluate(Chromosome *chromosome) const override {
+            const double x = (double) ((QuadraticCh*) chromosome)->getPhenotype();
+            double y = -1*pow(x, 2)+2*x+1;
+            if(std::isnan(y) || std::isinf(y))
+                y = __DBL_MIN__;
+            chromosome->fitness = y;
+        }
+
+        bool evaluateBatch(const std::vector<Chromosome*> &chromosomes) const override {
+            thread_local std::vector<double> x, y;
+            const unsigned int n = chromosomes.size();
+            x.resize(n);
+            y.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                x[i] = (double) ((QuadraticCh*) chromosomes[i])->getPhenotype();
+            for (unsigned int i = 0; i < n; i++)
+                y[i] = -x[i]*x[i] + 2*x[i] + 1;
+            for (unsigned int i = 0; i < n; i++)
+                chromosomes[i]->fitness = std::isnan(y[i]) || std::isinf(y[i]) ? __DBL_MIN__ : y[i];
+            return true;
+        }
+
+        QuadraticCh* generateChromosome() const override { return new QuadraticCh(10.0/(double)FLOAT_BITS); }
+};
+
+typedef FixedBitString<FLOAT_BITS> QuadraticValue; // Same model for GeneticAlgorithmT
+
+class QuadraticFitnessT {
+    public:
+        QuadraticValue generate(Uniform &rng) const {
+            QuadraticValue ch(10.0/(double)FLOAT_BITS, rng);
+            const float value = (float) rng.random(-100.0, 100.0);
+            uint32_t binary;
+            std::memcpy(&binary, &value, sizeof(binary));
+            ch.setBits(0, FLOAT_BITS, binary);
+            return ch;
+        }
+
+        double evaluate(const QuadraticValue &ch) const {
+            const uint32_t binary = (uint32_t) ch.getBits(0, FLOAT_BITS);
+            float value;
+            std::memcpy(&value, &binary, sizeof(value));
+            const double x = (double) value;
+            double y = -1*pow(x, 2)+2*x+1;
+            if(std::isnan(y) || std::isinf(y))
+                y = __DBL_MIN__;
+            return y;
+        }
+};
+
+class SubsetCh : public BitStringChromosome { // Bit i selects the i-th element of the set (subsetsum example)
+    public:
+        SubsetCh(const std::vector<unsigned int> *set, double mutProb) : BitStringChromosome(set->size(), mutProb), sum(0), set(set) {}
+
+        std::string getName() const override { return "Subset selection array"; }
+
+        unsigned int getPhenotype() const {
+            unsigned int total = 0;
+            for (unsigned int i = 0; i < length; i++)
+                if (getBit(i))
+                    total += set->at(i);
+            return total;
+        }
+
+        void clone(const Chromosome* other) override {
+            BitStringChromosome::clone(other);
+            sum = ((SubsetCh*) other)->sum;
+        }
+
+        void printPhenotype() const override { std::cout << "Phenotype: Sum = " << getPhenotype() << std::endl; }
+
+        void regenerate(const std::vector<unsigned int> *set) { // Random subset of another set of the same size
+            this->set = set;
+            randomize();
+        }
+
+        unsigned int sum; // Phenotype at the last evaluation, updated incrementally
+
+    private:
+        const std::vector<unsigned int> *set;
+};
+
+class SubsetSumFitness : public Fitness {
+    public:
+        SubsetSumFitness(const std::vector<unsigned int> *set, unsigned int target) : set(set), target(target) {}
+
+        std::string getName() const override { return "Subset sum function"; }
+
+        void evaluate(Chromosome *chromosome) const override {
+            SubsetCh *c = (SubsetCh*) chromosome;
+            c->sum = c->getPhenotype();
+            c->fitness = fitness(c->sum);
+        }
+
+        bool evaluateDelta(Chromosome *chromosome, const std::vector<unsigned int> &changedGenes) const override {
+            SubsetCh *c = (SubsetCh*) chromosome;
+            for (unsigned int i : changedGenes) {
+                if (c->getBit(i))
+                    c->sum += set->at(i);
+                else
+                    c->sum -= set->at(i);
+            }
+            c->fitness = fitness(c->sum);
+            return true;
+        }
+
+        SubsetCh* generateChromosome() const override { return new SubsetCh(set, 10.0/(double)set->size()); }
+
+        bool regenerateChromosome(Chromosome *chromosome) const override {
+            SubsetCh *c = (SubsetCh*) chromosome;
+            if(c->size() != set->size())
+                return false;
+            c->regenerate(set);
+            return true;
+        }
+
+    private:
+        const std::vector<unsigned int> *set;
+        unsigned int target;
+
+        inline double fitness(unsigned int sum) const { return 100.0 / (fabs((double) sum - (double) target) + 1.0); }
+};
+
+class RealCh : public Chromosome { // Single real number (moga example)
+    public:
+        RealCh() : Chromosome() { randomize(); }
+
+        std::string getName() const override { return "Single real number"; }
+        double getPhenotype() const { return x; }
+        void printPhenotype() const override { std::cout << x; }
+        void printGenotype() const override { std::cout << "Genotype: " << x << std::endl; }
+
+        void crossover(Chromosome* other) override {
+            x = (x + ((RealCh*) other)->x) / 2.0;
+            dirty = true;
+        }
+
+        void mutate() override {
+            randomize();
+            dirty = true;
+        }
+
+        void clone(const Chromosome* other) override {
+            x = ((RealCh*) other)->x;
+            objectives = other->objectives;
+            dirty = other->dirty;
+        }
+
+        uint64_t hash() const override {
+            uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return hashCombine(0, bits);
+        }
+
+    private:
+        double x;
+        inline void randomize() { x = uniform.random() * 20.0 - 10.0; }
+};
+
+class TwoObjectiveFitness : public Fitness { // f(x) = {x^2, (x-2)^2}
+    public:
+        std::string getName() const override { return "f(x) = {x^2, (x-2)^2}"; }
+
+        void evaluate(Chromosome *chromosome) const override {
+            const double x = ((RealCh*) chromosome)->getPhenotype();
+            chromosome->objectives = {pow(x, 2), pow(x - 2, 2)};
+        }
+
+        bool evaluateBatch(const std::vector<Chromosome*> &chromosomes) const override {
+            thread_local std::vector<double> x;
+            const unsigned int n = chromosomes.size();
+            x.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                x[i] = ((RealCh*) chromosomes[i])->getPhenotype();
+            for (unsigned int i = 0; i < n; i++) {
+                chromosomes[i]->objectives.resize(2);
+                chromosomes[i]->objectives[0] = x[i]*x[i];
+                chromosomes[i]->objectives[1] = (x[i] - 2)*(x[i] - 2);
+            }
+            return true;
+        }
+
+        RealCh* generateChromosome() const override { return new RealCh(); }
+};
+
+class BenchGA : public GeneticAlgorithm { // Exposes the steps of a generation
+    public:
+        BenchGA(Fitness *fitnessFunction, GAConfig *config) : GeneticAlgorithm(fitnessFunction, config) {}
+
+        using GeneticAlgorithm::sortPopulation;
+        using GeneticAlgorithm::selection;
+
+        void shuffle() { // Unsorted population, as found after the evaluation of a generation
+            for (unsigned int i = population.size() - 1; i > 0; i--)
+                std::swap(population[i], population[(unsigned int) uniform.random(i + 1)]);
+        }
+};
+
+class BenchMOGA : public MultiObjectiveGA { // Exposes the ranking of the population
+    public:
+        BenchMOGA(Fitness *fitnessFunction, GAConfig *config) : MultiObjectiveGA(fitnessFunction, config) {}
+
+        using MultiObjectiveGA::sortPopulation;
+        using MultiObjectiveGA::dominates;
+
+        void rank() { rankIndividuals(population, 0); } // Only the fronts
+        void crowding() { // Crowding distances of the fronts found by the last rank()
+            const unsigned int m = population[0]->objectives.size();
+            for (unsigned int f = 0; f < sorter.getFrontsCount(); f++)
+                crowdingDistance(f, m);
+        }
+};
+
+#endif // BENCH_MODELS_H
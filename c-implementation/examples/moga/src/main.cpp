@@ -8,6 +8,9 @@
 
 #include "../../src/lib/help.h"
 #include "../../src/lib/moga.h"
+#include "../../src/lib/island_ga.h"
+#include "../../src/lib/process_island_ga.h"
+#include "../../src/lib/real_vector_chromosome.h"
 
 
 /*
@@ -19,6 +22,10 @@
     Example 2 shows how to get the Pareto front for the following objectives:
         f1(x) = 2(x-1) + 1
         f2(x) = 2(x-3)^2 + 1
+
+    Example 3 (run with -z) is the ZDT1 benchmark, with 30 variables in [0, 1]:
+        f1(x) = x1
+        f2(x) = g(x) (1 - sqrt(x1 / g(x))), g(x) = 1 + 9 (x2 + ... + xn) / (n - 1)
 */
 
 int main(int argc, char **argv);
@@ -52,16 +59,35 @@ class RealNumberCh : public Chromosome {
             RealNumberCh *otherCh = (RealNumberCh*) other;
             double otherX = otherCh->getPhenotype();
             x = (x + otherX) / 2.0;
+            dirty = true;
         }
 
         void mutate() override {
             randomize();
+            dirty = true;
         }
 
         void clone(const Chromosome* other) override {
             RealNumberCh *otherCh = (RealNumberCh*) other;
             x = otherCh->getPhenotype();   
             objectives = otherCh->objectives;
+            dirty = otherCh->dirty;
+        }
+
+        uint64_t hash() const override {
+            uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return hashCombine(0, bits);
+        }
+
+        bool serialize(std::vector<uint8_t> &buffer) const override {
+            serializeValue(buffer, x);
+            return true;
+        }
+
+        bool deserialize(const uint8_t *&data, const uint8_t *end) override {
+            dirty = true;
+            return deserializeValue(data, end, x);
         }
 
     private:
@@ -86,9 +112,29 @@ class MOFitnessExample1 : public Fitness {
             c->objectives = {f1, f2};
         }
 
+        bool evaluateBatch(const std::vector<Chromosome*> &chromosomes) const override {
+            // Both objectives of a block of individuals, computed over a contiguous array of phenotypes
+            thread_local std::vector<double> x, f1, f2;
+            const unsigned int n = chromosomes.size();
+            x.resize(n);
+            f1.resize(n);
+            f2.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                x[i] = ((RealNumberCh*) chromosomes[i])->getPhenotype();
+            for (unsigned int i = 0; i < n; i++) {
+                f1[i] = x[i]*x[i];
+                f2[i] = (x[i] - 2)*(x[i] - 2);
+            }
+            for (unsigned int i = 0; i < n; i++) {
+                chromosomes[i]->objectives.resize(2);
+                chromosomes[i]->objectives[0] = f1[i];
+                chromosomes[i]->objectives[1] = f2[i];
+            }
+            return true;
+        }
+
         RealNumberCh* generateChromosome() const override {
             RealNumberCh *ch = new RealNumberCh();
-            evaluate(ch);
             return ch;
         }
 };
@@ -109,14 +155,71 @@ class MOFitnessExample2 : public Fitness {
             c->objectives = {f1, f2};
         }
 
+        bool evaluateBatch(const std::vector<Chromosome*> &chromosomes) const override {
+            // Both objectives of a block of individuals, computed over a contiguous array of phenotypes
+            thread_local std::vector<double> x, f1, f2;
+            const unsigned int n = chromosomes.size();
+            x.resize(n);
+            f1.resize(n);
+            f2.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                x[i] = ((RealNumberCh*) chromosomes[i])->getPhenotype();
+            for (unsigned int i = 0; i < n; i++) {
+                f1[i] = 2*(x[i] - 1) + 1;
+                f2[i] = 2*(x[i] - 3)*(x[i] - 3) + 1;
+            }
+            for (unsigned int i = 0; i < n; i++) {
+                chromosomes[i]->objectives.resize(2);
+                chromosomes[i]->objectives[0] = f1[i];
+                chromosomes[i]->objectives[1] = f2[i];
+            }
+            return true;
+        }
+
         RealNumberCh* generateChromosome() const override {
             RealNumberCh *ch = new RealNumberCh();
-            evaluate(ch);
             return ch;
         }
 };
 
 
+// Example 3
+// Many real variables, stored in a single RealVectorChromosome
+#define ZDT1_VARIABLES 30
+
+class ZDT1Fitness : public Fitness {
+    public:
+        ZDT1Fitness() : lower(ZDT1_VARIABLES, 0.0), upper(ZDT1_VARIABLES, 1.0) {}
+
+        std::string getName() const override {
+            return "ZDT1 (30 variables)";
+        }
+
+        void evaluate(Chromosome *chromosome) const {
+            RealVectorChromosome *c = (RealVectorChromosome*) chromosome;
+            const double *x = c->data();
+            const unsigned int n = c->size();
+            double sum = 0.0;
+            for (unsigned int i = 1; i < n; i++)
+                sum += x[i];
+            double g = 1.0 + 9.0 * sum / (double) (n - 1);
+            double f1 = x[0];
+            double f2 = g * (1.0 - sqrt(f1 / g));
+            c->objectives = {f1, f2};
+        }
+
+        RealVectorChromosome* generateChromosome() const override {
+            // Mutation probability of 1/n for each variable
+            RealVectorChromosome *ch = new RealVectorChromosome(&lower, &upper, 1.0/(double)ZDT1_VARIABLES);
+            return ch;
+        }
+
+    private:
+        std::vector<double> lower;
+        std::vector<double> upper;
+};
+
+
 int main(int argc, char **argv) {
 
     // Check for help flag
@@ -126,11 +229,32 @@ int main(int argc, char **argv) {
         }
     }
 
+    bool zdt1 = false; // Example 3 instead of example 1
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-z") == 0) {
+            zdt1 = true;
+        }
+    }
+
     GAConfig* config = new GAConfig();
     config->setConfig(argc, argv); // Set the configuration with the command line arguments
 
-    MultiObjectiveGA *moga = new MultiObjectiveGA(new MOFitnessExample1(), config);
-    GAResults results = moga->run();
+    GAResults results(OBJTYPE::MULTI);
+    IslandGA::Factory factory = [zdt1](GAConfig *c) {
+        Fitness *f = zdt1 ? (Fitness*) new ZDT1Fitness() : (Fitness*) new MOFitnessExample1();
+        return new MultiObjectiveGA(f, c);
+    };
+    if(config->islands > 1 && config->transport != TRANSPORT::THREADS){ // Islands in worker processes
+        ProcessIslandGA *islands = new ProcessIslandGA(factory, config);
+        results = islands->run();
+    }else if(config->islands > 1){ // Island model, the Pareto fronts of the islands are merged
+        IslandGA *islands = new IslandGA(factory, config);
+        results = islands->run();
+    }else{
+        Fitness *f = zdt1 ? (Fitness*) new ZDT1Fitness() : (Fitness*) new MOFitnessExample1();
+        MultiObjectiveGA *moga = new MultiObjectiveGA(f, config);
+        results = moga->run();
+    }
 
     // Set the output format with the command line arguments
     // Values are "txt", "csv", "svg", "html". Default is "txt"
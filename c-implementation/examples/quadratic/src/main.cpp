@@ -5,8 +5,9 @@
 #include <math.h>
 #include <cstring>
 #include <cstdlib>
-#include "util.h"
+#include <cstdint>
 #include "../../src/lib/ga.h"
+#include "../../src/lib/bitstring_chromosome.h"
 
 
 /*
@@ -20,54 +21,19 @@
 
 int main(int argc, char **argv);
 
-// First, we define the gene, which is the minimal unit of a chromosome.
-// In this case, it consist of a single boolean value.
-// This may seem like an overkill, but later we'll see that the chromosome 
-// class works with Gene type objects, to ease the problem modelling.
-class BoolGene : public Gene {
-    public:    
-        BoolGene() : Gene() {
-            randomize();
-        }
-
-        inline void randomize() override{
-            digit = uniform.random() < 0.5; //RANDOM
-        }
-
-        inline void print() const override {
-            std::cout << digit << " ";
-        }
-
-        inline bool getValue() const {
-            return digit;
-        }
-
-        inline void setValue(bool value) {
-            digit = value;
-        }
-
-    private:
-        bool digit;
-};
-
-
-// The chromosome class is a container for genes. It is basically an array of genes, 
-// which is the genotype, and it models a float number, which is its phenotype, using binary
-// to float conversion.
+// The chromosome models a float number, which is its phenotype, using its binary
+// representation as genotype. The library already provides a chromosome that stores
+// bits packed in machine words, along with the crossover and mutation operators, so 
+// we only need to define how the bits are decoded.
 // The chromosome is initialized with a random float value between -100 and 100.
-// Crossover and mutation operators are implemented in the base class, and thats why
-// we defined genes instead of directly using the chromosome class.
-class BinaryStringCh : public Chromosome { // Models a float value using binary code
+class BinaryStringCh : public BitStringChromosome { // Models a float value using binary code
     public:
-        BinaryStringCh(double mutProb) : Chromosome(mutProb) {
+        BinaryStringCh(double mutProb) : BitStringChromosome(FLOAT_BITS, mutProb) {
             // Generate random chromosome representing values between -100 and 100;
-            const double value = uniform.random(-100.0, 100.0);
-            std::vector<bool> binary = flt2Bin(value);
-            for (unsigned int i = 0; i < FLOAT_BITS; i++) {
-                BoolGene *b = new BoolGene();
-                b->setValue(binary[i]);
-                genes.push_back(b);
-            }
+            const float value = (float) uniform.random(-100.0, 100.0);
+            uint32_t binary;
+            std::memcpy(&binary, &value, sizeof(binary));
+            setBits(0, FLOAT_BITS, binary);
         }
 
         std::string getName() const override {
@@ -75,35 +41,16 @@ class BinaryStringCh : public Chromosome { // Models a float value using binary
         }
 
         float getPhenotype() const {
-            // Convert gene array to binary array and then to double
-            std::vector<bool> binaryArray;
-            for (Gene* gene : genes)
-                binaryArray.push_back(((BoolGene*)gene)->getValue());
-            return bin2Flt(binaryArray);
-        }
-
-        void printGenotype() const override {
-            std::cout << "Genotype: ";
-            for (Gene* gene : genes) {
-                gene->print();
-            }
-            std::cout << std::endl;
+            // Interpret the genotype bits as a float
+            uint32_t binary = (uint32_t) getBits(0, FLOAT_BITS);
+            float value;
+            std::memcpy(&value, &binary, sizeof(value));
+            return value;
         }
 
         void printPhenotype() const override {
             std::cout << "Phenotype: " << getPhenotype() << std::endl;
         }
-
-        void clone(const Chromosome* other) { // Copy the genes from another chromosome
-            std::vector<Gene*> otherGenes = other->getGenes();
-            std::vector<Gene*> thisGenes = getGenes();
-            for (unsigned int i = 0; i < otherGenes.size(); i++) {
-                BoolGene *thisGene = (BoolGene*) thisGenes[i];
-                BoolGene *otherGene = (BoolGene*) otherGenes[i];
-                thisGene->setValue(otherGene->getValue());
-            }
-            fitness = other->fitness;
-        }
 };
 
 // The fitness function is the quadratic function we want to maximize.
@@ -128,10 +75,25 @@ class QuadraticFitness : public Fitness {
             c->fitness = y;
         }
 
+        bool evaluateBatch(const std::vector<Chromosome*> &chromosomes) const override {
+            // Same function for a block of individuals. Phenotypes are decoded into a contiguous
+            // array, so the polynomial is computed by a loop the compiler can vectorize
+            thread_local std::vector<double> x, y;
+            const unsigned int n = chromosomes.size();
+            x.resize(n);
+            y.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                x[i] = (double) ((BinaryStringCh*) chromosomes[i])->getPhenotype();
+            for (unsigned int i = 0; i < n; i++)
+                y[i] = -x[i]*x[i] + 2*x[i] + 1;
+            for (unsigned int i = 0; i < n; i++)
+                chromosomes[i]->fitness = std::isnan(y[i]) || std::isinf(y[i]) ? __DBL_MIN__ : y[i];
+            return true;
+        }
+
         BinaryStringCh* generateChromosome() const override {
             double mutProb = 10.0/(double)FLOAT_BITS;
             BinaryStringCh *ch = new BinaryStringCh(mutProb);
-            evaluate(ch);
             return ch;
         }
 };
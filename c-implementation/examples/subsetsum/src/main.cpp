@@ -1,45 +1,17 @@
 #include "../../src/lib/help.h"
 #include "../../src/lib/uniform.h"
 #include "../../src/lib/ga.h"
+#include "../../src/lib/island_ga.h"
+#include "../../src/lib/process_island_ga.h"
+#include "../../src/lib/bitstring_chromosome.h"
 
 #define SET_SIZE 20
 
-class BoolGene : public Gene {
-    public:    
-        BoolGene() : Gene() {
-            randomize();
-        }
-
-        inline void randomize() override{
-            //digit = u_random() < 0.5;
-            digit = uniform.random() < 0.5; //RANDOM
-        }
-
-        inline void print() const override {
-            std::cout << digit << " ";
-        }
-
-        inline bool getValue() const {
-            return digit;
-        }
-
-        inline void setValue(bool value) {
-            digit = value;
-        }
-
-    private:
-        bool digit;
-};
-
-class BinaryStringCh : public Chromosome { // Models a float value using binary code
+class BinaryStringCh : public BitStringChromosome { // Bit i selects the i-th element of the set
     public:
-        BinaryStringCh(std::vector<unsigned int> *set, double mutProb) : Chromosome(mutProb) {
+        BinaryStringCh(std::vector<unsigned int> *set, double mutProb) : BitStringChromosome(set->size(), mutProb) {
             this->set = set;
-            unsigned int size = set->size();
-            for (unsigned int i = 0; i < size; i++) {
-                BoolGene *ig = new BoolGene();
-                genes.push_back(ig);
-            }
+            this->sum = 0;
         }
 
         std::string getName() const override {
@@ -48,49 +20,30 @@ class BinaryStringCh : public Chromosome { // Models a float value using binary
 
         unsigned int getPhenotype() const { // Sums selected (active genes) values from the set
             unsigned int sum = 0;
-            for (unsigned int i = 0; i < genes.size(); i++) {
-                BoolGene *gene = (BoolGene*) genes[i];
-                if (gene->getValue()) {
+            for (unsigned int i = 0; i < length; i++) {
+                if (getBit(i)) {
                     sum += set->at(i);
                 }
             }
             return sum;
         }
 
-        void printGenotype() const override {
-            std::cout << "Genotype: ";
-            for (Gene* gene : genes) {
-                gene->print();
-            }
-            std::cout << std::endl;
+        void clone(const Chromosome* other) override {
+            BitStringChromosome::clone(other);
+            sum = ((BinaryStringCh*) other)->sum;
         }
 
         void printPhenotype() const override {
             std::cout << "Phenotype: Subset = ";
-            for (unsigned int i = 0; i < genes.size(); i++) {
-                BoolGene *gene = (BoolGene*) genes[i];
-                if (gene->getValue()) {
+            for (unsigned int i = 0; i < length; i++) {
+                if (getBit(i)) {
                     std::cout << set->at(i) << " ";
                 }
             }
             std::cout << "- Sum = " << getPhenotype() << std::endl;
         }
 
-        void clone(const Chromosome* other) { // Copy the genes from another chromosome
-            std::vector<Gene*> otherGenes = other->getGenes();
-            // To access the child class methods, we need to cast the genes
-            std::vector<Gene*> thisGenes = getGenes(); 
-            for (unsigned int i = 0; i < otherGenes.size(); i++) {
-                BoolGene *thisGene = dynamic_cast<BoolGene*>(thisGenes[i]);
-                BoolGene *otherGene = dynamic_cast<BoolGene*>(otherGenes[i]);
-                if (thisGene && otherGene) {
-                    thisGene->setValue(otherGene->getValue());
-                } else {
-                    std::cerr << "Gene cast failed" << std::endl;
-                }
-            }
-            fitness = other->fitness;
-        }
+        unsigned int sum; // Phenotype at the last evaluation, updated incrementally
     
     private:
         std::vector<unsigned int> *set;
@@ -109,28 +62,39 @@ class SubSetSumFitness : public Fitness {
         
         void evaluate(Chromosome *chromosome) const override {
             BinaryStringCh *c = (BinaryStringCh*) chromosome;
-            unsigned int subSetSize = 0;
-            for(unsigned int i = 0; i < set->size(); i++){
-                BoolGene *gene = (BoolGene*) c->getGenes()[i];
-                if(gene->getValue()){
-                    subSetSize++;
-                }
-            }
-            const double error = abs((double) c->getPhenotype() - (double) target);
+            //const unsigned int subSetSize = c->count();
+            c->sum = c->getPhenotype();
             //const double sizeCost = (double)subSetSize/(double)set->size();
 
-            c->fitness = abs(100.0 / (error + 1.0));
+            c->fitness = fitness(c->sum);
+        }
+
+        bool evaluateDelta(Chromosome *chromosome, const std::vector<unsigned int> &changedGenes) const override {
+            // The sum is additive, so only the flipped elements are added or removed
+            BinaryStringCh *c = (BinaryStringCh*) chromosome;
+            for (unsigned int i : changedGenes) {
+                if (c->getBit(i))
+                    c->sum += set->at(i);
+                else
+                    c->sum -= set->at(i);
+            }
+            c->fitness = fitness(c->sum);
+            return true;
         }
 
         BinaryStringCh* generateChromosome() const override {
             BinaryStringCh *ch = new BinaryStringCh(set, 10.0/(double)set->size());
-            evaluate(ch);
             return ch;
         }
     
     private:
         std::vector<unsigned int> *set;
         unsigned int target;
+
+        inline double fitness(unsigned int sum) const {
+            const double error = abs((double) sum - (double) target);
+            return abs(100.0 / (error + 1.0));
+        }
 };
 
 
@@ -143,6 +107,12 @@ int main(int argc, char **argv) {
         }
     }
 
+    GAConfig* config = new GAConfig();
+    config->setConfig(argc, argv); 
+
+    // The problem instance is also generated from the configured seed
+    Uniform::setSeed(config->seed);
+
     // Target
     Uniform uniform;
     unsigned int target = (unsigned int) uniform.random(100, 200);
@@ -161,14 +131,23 @@ int main(int argc, char **argv) {
     std::cout << std::endl;
     std::cout << "Target: " << target << std::endl;
 
-    GAConfig* config = new GAConfig();
-    config->setConfig(argc, argv); 
-
-    GeneticAlgorithm *ga = new GeneticAlgorithm(new SubSetSumFitness(&set, target), config);
-    
-    ga->print();
-
-    GAResults results = ga->run();
+    GAResults results(OBJTYPE::SINGLE);
+    IslandGA::Factory factory = [&set, target](GAConfig *c) {
+        return new GeneticAlgorithm(new SubSetSumFitness(&set, target), c);
+    };
+    if(config->islands > 1 && config->transport != TRANSPORT::THREADS){ // Islands in worker processes
+        ProcessIslandGA *islands = new ProcessIslandGA(factory, config);
+        islands->print();
+        results = islands->run();
+    }else if(config->islands > 1){ // Island model, every island gets its own fitness function
+        IslandGA *islands = new IslandGA(factory, config);
+        islands->print();
+        results = islands->run();
+    }else{
+        GeneticAlgorithm *ga = new GeneticAlgorithm(new SubSetSumFitness(&set, target), config);
+        ga->print();
+        results = ga->run();
+    }
     
     results.print();
 
@@ -0,0 +1,189 @@
+#define MANUAL "manual.txt"
+
+#include <iostream>
+#include <vector>
+#include <math.h>
+#include <cstring>
+#include <cstdlib>
+
+#include "../../src/lib/help.h"
+#include "../../src/lib/uniform.h"
+#include "../../src/lib/ga.h"
+#include "../../src/lib/island_ga.h"
+#include "../../src/lib/process_island_ga.h"
+#include "../../src/lib/permutation_chromosome.h"
+
+/*
+    Travelling salesperson problem with random cities in the unit square. The tour is a
+    permutation of the cities and the fitness is 10000 / length, as in the javascript model.
+    Inversion mutations are 2-opt moves, so the length of a mutated tour is updated from the
+    4 edges that changed instead of adding the n edges again.
+
+    Example specific options:
+        -N cities               Number of cities (100 by default)
+        -x ox|pmx|erx           Crossover operator (ox by default)
+        -w                      Swap mutation instead of inversion
+*/
+
+#define CITIES 100
+
+class TourCh : public PermutationChromosome { // Order in which the cities are visited
+    public:
+        TourCh(unsigned int cities, double mutProb, PERMCROSSOVER crossoverType, PERMMUTATION mutationType) :
+            PermutationChromosome(cities, mutProb, crossoverType, mutationType) {
+            this->tourLength = 0.0;
+        }
+
+        std::string getName() const override {
+            return "Tour of the cities";
+        }
+
+        void clone(const Chromosome* other) override {
+            PermutationChromosome::clone(other);
+            tourLength = ((TourCh*) other)->tourLength;
+        }
+
+        void printPhenotype() const override {
+            std::cout << "Phenotype: Tour length = " << tourLength << std::endl;
+        }
+
+        double tourLength; // Phenotype at the last evaluation, updated incrementally
+};
+
+class TSPFitness : public Fitness {
+    public:
+        // Distances are stored in a single array (row i starts at i*cities) and must be symmetric
+        TSPFitness(const std::vector<double> *distances, unsigned int cities, PERMCROSSOVER crossoverType, PERMMUTATION mutationType) : Fitness() {
+            this->distances = distances->data();
+            this->cities = cities;
+            this->crossoverType = crossoverType;
+            this->mutationType = mutationType;
+        }
+
+        std::string getName() const override {
+            return "Travelling salesperson";
+        }
+
+        void evaluate(Chromosome *chromosome) const override {
+            TourCh *c = (TourCh*) chromosome;
+            const unsigned int *tour = c->data();
+            double length = distance(tour[cities - 1], tour[0]);
+            for (unsigned int i = 1; i < cities; i++)
+                length += distance(tour[i - 1], tour[i]);
+            c->tourLength = length;
+            c->fitness = fitness(length);
+        }
+
+        bool evaluateDelta(Chromosome *chromosome, const std::vector<unsigned int> &changedGenes) const override {
+            // Each move replaced some edges of the tour: (a, b) by (c, d) for every group of 4 cities
+            TourCh *c = (TourCh*) chromosome;
+            for (unsigned int i = 0; i + 3 < changedGenes.size(); i += 4)
+                c->tourLength += distance(changedGenes[i + 2], changedGenes[i + 3]) - distance(changedGenes[i], changedGenes[i + 1]);
+            c->fitness = fitness(c->tourLength);
+            return true;
+        }
+
+        bool cacheable() const override { // The tour length of a cached individual would not be updated
+            return false;
+        }
+
+        TourCh* generateChromosome() const override {
+            TourCh *ch = new TourCh(cities, 1.0/(double)cities, crossoverType, mutationType);
+            return ch;
+        }
+
+    private:
+        const double *distances;
+        unsigned int cities;
+        PERMCROSSOVER crossoverType;
+        PERMMUTATION mutationType;
+
+        inline double distance(unsigned int a, unsigned int b) const { return distances[a*cities + b]; }
+        inline double fitness(double length) const { return 10000.0 / length; }
+};
+
+
+int main(int argc, char **argv) {
+
+    // Check for help flag
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printHelp();
+        }
+    }
+
+    // Example specific options, the rest are read by the configuration
+    unsigned int cities = CITIES;
+    PERMCROSSOVER crossoverType = PERMCROSSOVER::OX;
+    PERMMUTATION mutationType = PERMMUTATION::INVERSION;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-N") == 0) {
+            if(i+1 < argc && atoi(argv[i + 1]) >= 3){
+                cities = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Number of cities not provided (at least 3)" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-x") == 0) {
+            if(i+1 < argc){
+                if(strcmp(argv[i + 1], "ox") == 0)
+                    crossoverType = PERMCROSSOVER::OX;
+                else if(strcmp(argv[i + 1], "pmx") == 0)
+                    crossoverType = PERMCROSSOVER::PMX;
+                else if(strcmp(argv[i + 1], "erx") == 0)
+                    crossoverType = PERMCROSSOVER::ERX;
+                else{
+                    std::cerr << "Error: Unknown crossover operator" << std::endl;
+                    printHelp();
+                }
+            }else{
+                std::cerr << "Error: Crossover operator not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-w") == 0) {
+            mutationType = PERMMUTATION::SWAP;
+        }
+    }
+
+    GAConfig* config = new GAConfig();
+    config->setConfig(argc, argv);
+
+    // The problem instance is also generated from the configured seed
+    Uniform::setSeed(config->seed);
+    Uniform uniform;
+    std::vector<double> x(cities), y(cities);
+    for (unsigned int i = 0; i < cities; i++) {
+        x[i] = uniform.random();
+        y[i] = uniform.random();
+    }
+    std::vector<double> distances(cities * cities);
+    for (unsigned int i = 0; i < cities; i++)
+        for (unsigned int j = 0; j < cities; j++)
+            distances[i*cities + j] = sqrt((x[i]-x[j])*(x[i]-x[j]) + (y[i]-y[j])*(y[i]-y[j]));
+
+    std::cout << std::endl << "Cities: " << cities << std::endl;
+
+    GAResults results(OBJTYPE::SINGLE);
+    IslandGA::Factory factory = [&distances, cities, crossoverType, mutationType](GAConfig *c) {
+        return new GeneticAlgorithm(new TSPFitness(&distances, cities, crossoverType, mutationType), c);
+    };
+    if(config->islands > 1 && config->transport != TRANSPORT::THREADS){ // Islands in worker processes
+        ProcessIslandGA *islands = new ProcessIslandGA(factory, config);
+        islands->print();
+        results = islands->run();
+    }else if(config->islands > 1){ // Island model, every island gets its own fitness function
+        IslandGA *islands = new IslandGA(factory, config);
+        islands->print();
+        results = islands->run();
+    }else{
+        GeneticAlgorithm *ga = new GeneticAlgorithm(new TSPFitness(&distances, cities, crossoverType, mutationType), config);
+        ga->print();
+        results = ga->run();
+    }
+
+    results.print();
+
+    std::cout << "Tour length: " << 10000.0 / results.best->fitness << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include "bitstring_chromosome.h"
+
+BitStringChromosome::BitStringChromosome(unsigned int length, double mutProb, BITCROSSOVER crossoverType) :
+    Chromosome(mutProb),
+    length(length),
+    words((length + 63) / 64, 0),
+    changes((length + 63) / 64, 0),
+    tracked(false),
+    crossoverType(crossoverType) {
+    randomize();
+}
+
+void BitStringChromosome::randomize() {
+    for (unsigned int w = 0; w < words.size(); w++)
+        words[w] = uniform.bits();
+    if(!words.empty())
+        words.back() &= tailMask();
+    dirty = true;
+    tracked = false;
+}
+
+void BitStringChromosome::mutate() { // Flip each bit with probability mutProb
+    if(mutProb <= 0.0 || length == 0)
+        return;
+    if(mutProb >= 1.0){
+        for (unsigned int w = 0; w < words.size(); w++){
+            words[w] = ~words[w];
+            changes[w] = ~changes[w];
+        }
+        words.back() &= tailMask();
+        changes.back() &= tailMask();
+        dirty = true;
+        return;
+    }
+    // Instead of drawing a number per bit, jump to the next flipped bit using
+    // the geometric distribution of the gaps between flips
+    const double logq = log(1.0 - mutProb);
+    double pos = floor(log(1.0 - uniform.random()) / logq);
+    while(pos < (double) length){
+        flipBit((unsigned int) pos);
+        pos += 1.0 + floor(log(1.0 - uniform.random()) / logq);
+    }
+}
+
+void BitStringChromosome::crossover(Chromosome* other) {
+    BitStringChromosome *otherCh = (BitStringChromosome*) other;
+    switch (crossoverType) {
+        case BITCROSSOVER::SINGLE:
+            singlePointCrossover(otherCh);
+            break;
+        case BITCROSSOVER::DOUBLE:
+            twoPointCrossover(otherCh);
+            break;
+        case BITCROSSOVER::UNIFORM:
+            uniformCrossover(otherCh);
+            break;
+    }
+}
+
+void BitStringChromosome::swapRange(BitStringChromosome* other, unsigned int from, unsigned int to) {
+    // Swap bits in [from, to) with the other chromosome, a whole word at a time
+    uint64_t changed = 0;
+    while(from < to){
+        const unsigned int w = from >> 6;
+        const unsigned int offset = from & 63;
+        const unsigned int n = std::min(64 - offset, to - from);
+        const uint64_t mask = (n == 64 ? ~0ULL : ((1ULL << n) - 1)) << offset;
+        const uint64_t diff = (words[w] ^ other->words[w]) & mask;
+        words[w] ^= diff;
+        other->words[w] ^= diff;
+        changes[w] ^= diff;
+        other->changes[w] ^= diff;
+        changed |= diff;
+        from += n;
+    }
+    if(changed != 0){
+        dirty = true;
+        other->dirty = true;
+    }
+}
+
+void BitStringChromosome::singlePointCrossover(BitStringChromosome* other) {
+    unsigned int pivot = (unsigned int) floor(uniform.random(length));
+    swapRange(other, 0, pivot);
+}
+
+void BitStringChromosome::twoPointCrossover(BitStringChromosome* other) {
+    unsigned int p1 = (unsigned int) floor(uniform.random(length));
+    unsigned int p2 = (unsigned int) floor(uniform.random(length));
+    if(p1 > p2)
+        std::swap(p1, p2);
+    swapRange(other, p1, p2);
+}
+
+void BitStringChromosome::uniformCrossover(BitStringChromosome* other) {
+    uint64_t changed = 0;
+    for (unsigned int w = 0; w < words.size(); w++) {
+        const uint64_t diff = (words[w] ^ other->words[w]) & uniform.bits();
+        words[w] ^= diff;
+        other->words[w] ^= diff;
+        changes[w] ^= diff;
+        other->changes[w] ^= diff;
+        changed |= diff;
+    }
+    if(changed != 0){
+        dirty = true;
+        other->dirty = true;
+    }
+}
+
+void BitStringChromosome::clone(const Chromosome* other) {
+    const BitStringChromosome *otherCh = (const BitStringChromosome*) other;
+    length = otherCh->length; // The genome may have another length
+    mutProb = otherCh->mutProb;
+    crossoverType = otherCh->crossoverType;
+    words = otherCh->words;
+    changes = otherCh->changes;
+    tracked = otherCh->tracked;
+    fitness = other->fitness;
+    objectives = other->objectives;
+    dirty = other->dirty;
+}
+
+uint64_t BitStringChromosome::hash() const {
+    uint64_t h = length;
+    for (unsigned int w = 0; w < words.size(); w++)
+        h = hashCombine(h, words[w]);
+    return h == 0 ? 1 : h; // 0 is reserved
+}
+
+bool BitStringChromosome::getChangedGenes(std::vector<unsigned int> &positions) const {
+    if(!tracked)
+        return false;
+    positions.clear();
+    for (unsigned int w = 0; w < changes.size(); w++) {
+        uint64_t mask = changes[w];
+        while(mask != 0){ // Bits that flipped an even number of times are not listed
+            positions.push_back((w << 6) + __builtin_ctzll(mask));
+            mask &= mask - 1;
+        }
+    }
+    return true;
+}
+
+void BitStringChromosome::evaluated() { // The current genotype is the new reference
+    std::fill(changes.begin(), changes.end(), 0);
+    tracked = true;
+    dirty = false;
+}
+
+bool BitStringChromosome::serialize(std::vector<uint8_t> &buffer) const {
+    serializeValue(buffer, (uint32_t) length);
+    for (unsigned int w = 0; w < words.size(); w++)
+        serializeValue(buffer, words[w]);
+    return true;
+}
+
+bool BitStringChromosome::deserialize(const uint8_t *&data, const uint8_t *end) {
+    uint32_t n;
+    if(!deserializeValue(data, end, n) || n != length)
+        return false;
+    for (unsigned int w = 0; w < words.size(); w++)
+        if(!deserializeValue(data, end, words[w]))
+            return false;
+    std::fill(changes.begin(), changes.end(), 0);
+    tracked = false;
+    dirty = true;
+    return true;
+}
+
+uint64_t BitStringChromosome::getBits(unsigned int from, unsigned int count) const {
+    const unsigned int w = from >> 6;
+    const unsigned int offset = from & 63;
+    uint64_t value = words[w] >> offset;
+    if(offset != 0 && offset + count > 64)
+        value |= words[w + 1] << (64 - offset);
+    return count == 64 ? value : value & ((1ULL << count) - 1);
+}
+
+void BitStringChromosome::setBits(unsigned int from, unsigned int count, uint64_t value) {
+    for (unsigned int i = 0; i < count; i++)
+        setBit(from + i, (value >> i) & 1ULL);
+}
+
+unsigned int BitStringChromosome::count() const {
+    unsigned int total = 0;
+    for (unsigned int w = 0; w < words.size(); w++)
+        total += __builtin_popcountll(words[w]);
+    return total;
+}
+
+unsigned int BitStringChromosome::count(unsigned int from, unsigned int to) const {
+    unsigned int total = 0;
+    while(from < to){
+        const unsigned int n = std::min(64 - (from & 63), to - from);
+        total += __builtin_popcountll(getBits(from, n));
+        from += n;
+    }
+    return total;
+}
+
+unsigned int BitStringChromosome::hammingDistance(const BitStringChromosome* other) const {
+    unsigned int total = 0;
+    for (unsigned int w = 0; w < words.size(); w++)
+        total += __builtin_popcountll(words[w] ^ other->words[w]);
+    return total;
+}
+
+void BitStringChromosome::printGenotype() const {
+    std::cout << "Genotype: ";
+    for (unsigned int i = 0; i < length; i++)
+        std::cout << getBit(i) << " ";
+    std::cout << std::endl;
+}
@@ -0,0 +1,68 @@
+#ifndef BITSTRING_CHROMOSOME_H
+#define BITSTRING_CHROMOSOME_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <math.h>
+#include "chromosome.h"
+
+enum class BITCROSSOVER {SINGLE, DOUBLE, UNIFORM};
+
+class BitStringChromosome : public Chromosome { // Binary genome packed in 64 bit words (bit i is in word i/64)
+    public:
+        BitStringChromosome(unsigned int length, double mutProb, BITCROSSOVER crossoverType = BITCROSSOVER::SINGLE);
+
+        std::string getName() const override { return "Bit string"; }
+
+        void mutate() override; // Bit-flip mutation
+        void crossover(Chromosome* other) override; // Uses the operator selected in the constructor
+        void clone(const Chromosome* other) override;
+        uint64_t hash() const override;
+        bool getChangedGenes(std::vector<unsigned int> &positions) const override;
+        void evaluated() override;
+        bool serialize(std::vector<uint8_t> &buffer) const override;
+        bool deserialize(const uint8_t *&data, const uint8_t *end) override;
+
+        void singlePointCrossover(BitStringChromosome* other);
+        void twoPointCrossover(BitStringChromosome* other);
+        void uniformCrossover(BitStringChromosome* other);
+
+        void randomize();
+
+        inline unsigned int size() const { return length; }
+        inline const std::vector<uint64_t>& getWords() const { return words; }
+
+        // Bit setters mark the chromosome as modified
+        inline bool getBit(unsigned int i) const { return (words[i >> 6] >> (i & 63)) & 1ULL; }
+        inline void setBit(unsigned int i, bool value) {
+            if(getBit(i) != value)
+                flipBit(i);
+        }
+        inline void flipBit(unsigned int i) { 
+            words[i >> 6] ^= 1ULL << (i & 63); 
+            changes[i >> 6] ^= 1ULL << (i & 63);
+            dirty = true; 
+        }
+
+        uint64_t getBits(unsigned int from, unsigned int count) const; // Up to 64 bits as an integer (bit "from" is the LSB)
+        void setBits(unsigned int from, unsigned int count, uint64_t value);
+
+        unsigned int count() const; // Number of bits set
+        unsigned int count(unsigned int from, unsigned int to) const; // Number of bits set in [from, to)
+        unsigned int hammingDistance(const BitStringChromosome* other) const;
+
+        void printGenotype() const override;
+
+    protected:
+        unsigned int length;
+        std::vector<uint64_t> words;
+        std::vector<uint64_t> changes; // Bits that differ from the last evaluated genotype
+        bool tracked; // False until the first evaluation or after a randomization
+        BITCROSSOVER crossoverType;
+
+        void swapRange(BitStringChromosome* other, unsigned int from, unsigned int to); // Marks both as modified if any bit differs
+        inline uint64_t tailMask() const { return (length & 63) == 0 ? ~0ULL : (1ULL << (length & 63)) - 1; }
+};
+
+#endif // BITSTRING_CHROMOSOME_H
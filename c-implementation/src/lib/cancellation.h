@@ -0,0 +1,18 @@
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+
+class CancellationToken { // Flag used by other threads to stop a run, checked between evaluations
+    public:
+        CancellationToken() : cancelled(false) {}
+
+        inline void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+        inline void reset() { cancelled.store(false, std::memory_order_relaxed); } // The token can be reused by a new run
+        inline bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> cancelled;
+};
+
+#endif // CANCELLATION_H
@@ -0,0 +1,100 @@
+#include "checkpoint.h"
+
+#include <iostream>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CHECKPOINT_MAGIC 0x434E4144 // "DNAC"
+#define CHECKPOINT_VERSION 1
+
+struct CheckpointHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+Checkpoint::Checkpoint(const std::string &path) : path(path), hasPending(false), writing(false), stop(false) {
+    writer = std::thread(&Checkpoint::writerLoop, this);
+}
+
+Checkpoint::~Checkpoint() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+void Checkpoint::write(std::vector<uint8_t> &payload) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        pending.swap(payload);
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+void Checkpoint::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]{ return !hasPending && !writing; });
+}
+
+void Checkpoint::writerLoop() {
+    std::vector<uint8_t> payload;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        wake.wait(lock, [this]{ return hasPending || stop; });
+        if(!hasPending) // Stops once the last checkpoint is written
+            break;
+        payload.swap(pending);
+        hasPending = false;
+        writing = true;
+        lock.unlock();
+        if(!save(payload))
+            std::cerr << "Checkpoint: cannot write " << path << std::endl;
+        lock.lock();
+        writing = false;
+        done.notify_all();
+    }
+}
+
+uint64_t Checkpoint::checksum(const std::vector<uint8_t> &payload) { // FNV-1a
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for(uint8_t byte : payload){
+        h ^= byte;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+bool Checkpoint::save(const std::vector<uint8_t> &payload) {
+    const std::string temporary = path + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    if(file == nullptr)
+        return false;
+    CheckpointHeader header = {CHECKPOINT_MAGIC, CHECKPOINT_VERSION, payload.size(), checksum(payload)};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && (payload.empty() || fwrite(payload.data(), payload.size(), 1, file) == 1)
+        && fflush(file) == 0
+        && fsync(fileno(file)) == 0; // Data is on disk before the rename
+    ok = fclose(file) == 0 && ok;
+    return ok && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool Checkpoint::read(const std::string &path, std::vector<uint8_t> &payload) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if(file == nullptr)
+        return false;
+    CheckpointHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION;
+    if(ok){
+        payload.resize(header.size);
+        ok = payload.empty() || fread(payload.data(), payload.size(), 1, file) == 1;
+    }
+    fclose(file);
+    return ok && checksum(payload) == header.checksum;
+}
@@ -0,0 +1,39 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+class Checkpoint { // File with the state of a run: header (magic, version, size, checksum) and payload
+    public:
+        Checkpoint(const std::string &path); // Starts the writer thread
+        ~Checkpoint(); // Waits for the last checkpoint to be written
+
+        // The payload is taken by swapping buffers, so the caller gets an old buffer to reuse.
+        // If the previous checkpoint is still being written, the newest one waiting replaces any older one
+        void write(std::vector<uint8_t> &payload);
+        void wait(); // Returns once every checkpoint requested has been written
+
+        static bool read(const std::string &path, std::vector<uint8_t> &payload); // Fails on corrupted files
+
+    private:
+        std::string path;
+        std::thread writer;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::vector<uint8_t> pending;
+        bool hasPending;
+        bool writing;
+        bool stop;
+
+        void writerLoop();
+        bool save(const std::vector<uint8_t> &payload); // Temporary file and rename, so the checkpoint is never half written
+        static uint64_t checksum(const std::vector<uint8_t> &payload);
+};
+
+#endif // CHECKPOINT_H
@@ -1,7 +1,13 @@
 #include "chromosome.h"
 
+// Genes and chromosomes do not own a generator, they draw from the stream of the thread using them
+LocalUniform Gene::uniform;
+LocalUniform Chromosome::uniform;
+
 Chromosome::Chromosome(const Chromosome& ch) : genes(ch.genes) {
     mutProb = ch.mutProb;
+    fitness = ch.fitness;
+    dirty = ch.dirty;
 }
 
 Chromosome::~Chromosome() {
@@ -11,8 +17,10 @@ Chromosome::~Chromosome() {
 
 void Chromosome::mutate() { // Mutate each gene with a probability of 1/genes.size()
     for (unsigned int i = 0; i < genes.size(); i++) {
-        if (uniform.random() < mutProb)
+        if (uniform.random() < mutProb){
             genes[i]->randomize();
+            dirty = true;
+        }
     }
 }
 
@@ -22,6 +30,25 @@ void Chromosome::crossover(Chromosome* other) { // Single point crossover
     for (unsigned int i = 0; i < pivot; i++){
         std::swap(genes[i], other->genes[i]);
     }
+    if(pivot > 0){
+        dirty = true;
+        other->dirty = true;
+    }
+}
+
+bool Chromosome::serialize(std::vector<uint8_t> &buffer) const {
+    for (unsigned int i = 0; i < genes.size(); i++)
+        if(!genes[i]->serialize(buffer))
+            return false;
+    return true;
+}
+
+bool Chromosome::deserialize(const uint8_t *&data, const uint8_t *end) {
+    for (unsigned int i = 0; i < genes.size(); i++)
+        if(!genes[i]->deserialize(data, end))
+            return false;
+    dirty = true;
+    return true;
 }
 
 void Chromosome::printGenotype() const { 
@@ -4,19 +4,30 @@
 #include <iostream>
 #include <vector>
 #include <cstdlib>
+#include <cstdint>
+#include <math.h>
 #include "gene.h"
 
 class Chromosome { // Abstract class that models a chromosome (list of genes with GA operators)
     public:
-        Chromosome(){};
+        Chromosome() : fitness(0.0), dirty(true), mutProb(0.0) {};
         Chromosome(const Chromosome& ch);
         virtual ~Chromosome();
 
         virtual std::string getName() const = 0;
 
+        // Operators must set the dirty flag of the modified chromosomes, and clone must copy it
         virtual void mutate(); 
         virtual void crossover(Chromosome* other);
-        virtual void clone(const Chromosome* other) = 0; // Copy genes and fitness value
+        virtual void clone(const Chromosome* other) = 0; // Copy genes, fitness value and dirty flag
+        virtual uint64_t hash() const { return 0; } // Genotype hash used to reuse evaluations (0 means not available)
+        virtual bool getChangedGenes(std::vector<unsigned int> &) const { return false; } // Genes that differ from the last evaluated genotype (false if not tracked)
+        virtual void evaluated() { dirty = false; } // Called by the engine once the fitness is up to date
+
+        // Genotype as raw bytes, used to send chromosomes to other processes. By default each gene
+        // is serialized. A deserialized chromosome is marked as modified, so it is evaluated again
+        virtual bool serialize(std::vector<uint8_t> &buffer) const;
+        virtual bool deserialize(const uint8_t *&data, const uint8_t *end);
         
         inline std::vector<Gene*> getGenes() const { return genes; }
         inline void setGenes(std::vector<Gene*> genes) { this->genes = genes; }
@@ -25,19 +36,25 @@ class Chromosome { // Abstract class that models a chromosome (list of genes wit
         virtual void printPhenotype() const = 0;
 
         double fitness; // Fitness value of the chromosome (value is updated by the fitness function)
+        bool dirty; // Genes changed after the last evaluation
 
-        // For multi-objective optimization
+        // For multi-objective optimization, set by the fitness function. Fronts and crowding
+        // distances are kept by MultiObjectiveGA in arrays indexed by population slot
         std::vector<double> objectives; 
-        std::vector<Chromosome*> dominatedChromosomes;
-        unsigned int dominationCount;
-        double crowdingDistance;
     
     protected:
-        Chromosome(double mutProb) : mutProb(mutProb) {}
+        Chromosome(double mutProb) : fitness(0.0), dirty(true), mutProb(mutProb) {}
+
+        static inline uint64_t hashCombine(uint64_t seed, uint64_t value) { // Helper to build genotype hashes
+            uint64_t z = seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
 
         std::vector<Gene*> genes; 
         double mutProb;
-        Uniform uniform;
+        static LocalUniform uniform; // Stream of the calling thread
 };
 
 #endif // CHROMOSOME_H
\ No newline at end of file
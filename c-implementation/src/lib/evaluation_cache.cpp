@@ -0,0 +1,106 @@
+#include "evaluation_cache.h"
+
+EvaluationCache::EvaluationCache(unsigned int capacity) : capacity(capacity), objectivesCount(0) {
+    unsigned int tableSize = 1;
+    while(tableSize < 2*capacity) // Keep the load factor under 0.5
+        tableSize <<= 1;
+    table.resize(tableSize);
+    keys.resize(capacity);
+    referenced.resize(capacity);
+    fitness.resize(capacity);
+    clear();
+}
+
+void EvaluationCache::clear() {
+    std::fill(table.begin(), table.end(), 0);
+    size = 0;
+    hand = 0;
+    hits = 0;
+    misses = 0;
+}
+
+unsigned int EvaluationCache::find(uint64_t hash) const {
+    const unsigned int mask = table.size() - 1;
+    unsigned int slot = (unsigned int) (hash ^ (hash >> 32)) & mask;
+    while(table[slot] != 0 && keys[table[slot] - 1] != hash)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+bool EvaluationCache::lookup(uint64_t hash, Chromosome *chromosome) {
+    if(capacity == 0){
+        misses++;
+        return false;
+    }
+    const unsigned int slot = find(hash);
+    if(table[slot] == 0){
+        misses++;
+        return false;
+    }
+    const unsigned int entry = table[slot] - 1;
+    referenced[entry] = true;
+    chromosome->fitness = fitness[entry];
+    chromosome->objectives.assign(objectives.begin() + entry*objectivesCount, objectives.begin() + (entry + 1)*objectivesCount);
+    hits++;
+    return true;
+}
+
+void EvaluationCache::insert(uint64_t hash, const Chromosome *chromosome) {
+    if(capacity == 0)
+        return;
+    if(objectivesCount != chromosome->objectives.size()){ // Size is known after the first evaluation
+        objectivesCount = chromosome->objectives.size();
+        objectives.assign(capacity * objectivesCount, 0.0);
+        std::fill(table.begin(), table.end(), 0);
+        size = 0;
+        hand = 0;
+    }
+
+    unsigned int slot = find(hash);
+    if(table[slot] != 0){ // Already stored
+        store(table[slot] - 1, chromosome);
+        return;
+    }
+
+    unsigned int entry;
+    if(size < capacity){
+        entry = size++;
+    }else{
+        // CLOCK: the hand clears reference bits until it finds an entry that was not used
+        while(referenced[hand]){
+            referenced[hand] = false;
+            hand = (hand + 1) % capacity;
+        }
+        entry = hand;
+        hand = (hand + 1) % capacity;
+        erase(find(keys[entry]));
+        slot = find(hash); // Slots may have moved
+    }
+    keys[entry] = hash;
+    table[slot] = entry + 1;
+    store(entry, chromosome);
+}
+
+void EvaluationCache::store(unsigned int entry, const Chromosome *chromosome) {
+    referenced[entry] = false;
+    fitness[entry] = chromosome->fitness;
+    std::copy(chromosome->objectives.begin(), chromosome->objectives.end(), objectives.begin() + entry*objectivesCount);
+}
+
+void EvaluationCache::erase(unsigned int slot) {
+    // Backward shift deletion, so no tombstones are needed
+    const unsigned int mask = table.size() - 1;
+    table[slot] = 0;
+    unsigned int next = (slot + 1) & mask;
+    while(table[next] != 0){
+        const uint64_t hash = keys[table[next] - 1];
+        const unsigned int home = (unsigned int) (hash ^ (hash >> 32)) & mask;
+        // Move the entry back if its home is not in the (cyclic) range (slot, next]
+        if(((next - home) & mask) >= ((next - slot) & mask)){
+            table[slot] = table[next];
+            table[next] = 0;
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
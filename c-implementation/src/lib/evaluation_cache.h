@@ -0,0 +1,39 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <vector>
+#include <cstdint>
+#include "chromosome.h"
+
+class EvaluationCache { // Bounded map from genotype hashes to fitness and objectives, with CLOCK eviction
+    public:
+        EvaluationCache(unsigned int capacity);
+
+        bool lookup(uint64_t hash, Chromosome *chromosome); // Copies the stored values into the chromosome if found
+        void insert(uint64_t hash, const Chromosome *chromosome);
+        void clear();
+
+        inline unsigned int getCapacity() const { return capacity; }
+        inline unsigned long getHits() const { return hits; }
+        inline unsigned long getMisses() const { return misses; }
+
+    private:
+        unsigned int capacity;
+        unsigned int size;
+        unsigned int objectivesCount;
+        unsigned int hand; // Position of the CLOCK hand
+        unsigned long hits;
+        unsigned long misses;
+
+        std::vector<unsigned int> table; // Open addressing (linear probing), entry index + 1 or 0 if empty
+        std::vector<uint64_t> keys;
+        std::vector<bool> referenced;
+        std::vector<double> fitness;
+        std::vector<double> objectives; // objectivesCount values per entry
+
+        unsigned int find(uint64_t hash) const; // Table slot of the hash, or of the empty slot where it would go
+        void erase(unsigned int slot);
+        void store(unsigned int entry, const Chromosome *chromosome);
+};
+
+#endif // EVALUATION_CACHE_H
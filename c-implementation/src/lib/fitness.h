@@ -8,7 +8,19 @@ class Fitness { // Abstract class that models a fitness function
         virtual ~Fitness() = default;
         virtual std::string getName() const = 0;        
         virtual void evaluate(Chromosome *chromosome) const = 0;
-        virtual Chromosome* generateChromosome() const = 0;
+        // Optional incremental evaluation from the previous fitness and the genes that changed since then.
+        // Returns false to fall back to evaluate()
+        virtual bool evaluateDelta(Chromosome *, const std::vector<unsigned int> &) const { return false; }
+        // Optional evaluation of many individuals in one call, so the fitness can be computed with vector
+        // kernels. The engine calls it from several threads with disjoint blocks. Returns false to fall back to evaluate()
+        virtual bool evaluateBatch(const std::vector<Chromosome*> &) const { return false; }
+        // The evaluation cache only restores the fitness and objectives. Fitness functions that also set
+        // other values of the chromosome (e.g. a phenotype shown in the results) return false to disable it
+        virtual bool cacheable() const { return true; }
+        virtual Chromosome* generateChromosome() const = 0; // Only called on initialization, no need to evaluate it
+        // Optional reinitialization, in place and as generateChromosome() would do it, of a chromosome generated by
+        // a fitness function of the same class. Used by GeneticAlgorithm::reset(). Returns false to allocate new ones
+        virtual bool regenerateChromosome(Chromosome *) const { return false; }
 
     protected:
         Fitness() = default;
@@ -0,0 +1,86 @@
+#ifndef FIXED_BITSTRING_H
+#define FIXED_BITSTRING_H
+
+#include <array>
+#include <cstdint>
+#include <math.h>
+#include "uniform.h"
+
+template<unsigned int N>
+class FixedBitString { // Value type with N bits, for GeneticAlgorithmT (no virtual methods and no heap memory)
+    public:
+        static const unsigned int WORDS = (N + 63) / 64;
+
+        FixedBitString() : fitness(0.0), dirty(true), mutProb(0.0) { words.fill(0); }
+        FixedBitString(double mutProb, Uniform &rng) : fitness(0.0), dirty(true), mutProb(mutProb) { randomize(rng); }
+
+        inline void randomize(Uniform &rng) {
+            for (unsigned int w = 0; w < WORDS; w++)
+                words[w] = rng.bits();
+            words[WORDS - 1] &= tailMask();
+            dirty = true;
+        }
+
+        inline void mutate(Uniform &rng) { // Flip each bit with probability mutProb
+            if(mutProb <= 0.0)
+                return;
+            // Jumps to the next flipped bit, as BitStringChromosome::mutate()
+            const double logq = log(1.0 - mutProb);
+            double pos = floor(log(1.0 - rng.random()) / logq);
+            while(pos < (double) N){
+                flipBit((unsigned int) pos);
+                pos += 1.0 + floor(log(1.0 - rng.random()) / logq);
+            }
+        }
+
+        inline void crossover(FixedBitString &other, Uniform &rng) { // Single point, bits before the pivot are swapped
+            const unsigned int pivot = (unsigned int) floor(rng.random(N));
+            uint64_t changed = 0;
+            for (unsigned int w = 0; w < WORDS && (w << 6) < pivot; w++) {
+                const unsigned int n = pivot - (w << 6);
+                const uint64_t mask = n >= 64 ? ~0ULL : (1ULL << n) - 1;
+                const uint64_t diff = (words[w] ^ other.words[w]) & mask;
+                words[w] ^= diff;
+                other.words[w] ^= diff;
+                changed |= diff;
+            }
+            if(changed != 0){
+                dirty = true;
+                other.dirty = true;
+            }
+        }
+
+        inline bool getBit(unsigned int i) const { return (words[i >> 6] >> (i & 63)) & 1ULL; }
+        inline void flipBit(unsigned int i) {
+            words[i >> 6] ^= 1ULL << (i & 63);
+            dirty = true;
+        }
+
+        inline uint64_t getBits(unsigned int from, unsigned int count) const { // Up to 64 bits (bit "from" is the LSB)
+            const unsigned int w = from >> 6;
+            const unsigned int offset = from & 63;
+            uint64_t value = words[w] >> offset;
+            if(offset != 0 && offset + count > 64)
+                value |= words[w + 1] << (64 - offset);
+            return count == 64 ? value : value & ((1ULL << count) - 1);
+        }
+
+        inline void setBits(unsigned int from, unsigned int count, uint64_t value) {
+            for (unsigned int i = 0; i < count; i++)
+                if(getBit(from + i) != ((value >> i) & 1ULL))
+                    flipBit(from + i);
+        }
+
+        inline const std::array<uint64_t, WORDS>& getWords() const { return words; }
+
+        double fitness;
+        bool dirty; // Genes changed after the last evaluation
+
+    private:
+        std::array<uint64_t, WORDS> words;
+        double mutProb;
+
+        static inline uint64_t tailMask() { return (N & 63) == 0 ? ~0ULL : (1ULL << (N & 63)) - 1; }
+};
+
+#endif // FIXED_BITSTRING_H
@@ -1,8 +1,21 @@
 #include "ga.h"
+#include "run_handle.h"
+
+LocalUniform GeneticAlgorithm::uniform;
 
 GeneticAlgorithm::GeneticAlgorithm() { 
     // Initialize with default configuration
     config = new GAConfig();
+    fitnessFunction = nullptr;
+    pool = nullptr;
+    cache = nullptr;
+    checkpoint = nullptr;
+    telemetry = nullptr;
+    selectionMethod = nullptr;
+    bestChromosome = nullptr;
+    chromosomesSource = nullptr;
+    selectionType = SELECTION::ROULETTE;
+    improved = false;
     // Cannot initialize with default constructor
 }
 
@@ -10,6 +23,15 @@ GeneticAlgorithm::GeneticAlgorithm(Fitness *fitnessFunction, GAConfig *config) {
     // Initialize with a fitness function and configuration
     this->config = config;
     this->fitnessFunction = fitnessFunction;
+    pool = nullptr;
+    cache = nullptr;
+    checkpoint = nullptr;
+    telemetry = nullptr;
+    selectionMethod = nullptr;
+    bestChromosome = nullptr;
+    chromosomesSource = nullptr;
+    selectionType = SELECTION::ROULETTE;
+    improved = false;
     initialize();
 }
 
@@ -17,6 +39,16 @@ GeneticAlgorithm::~GeneticAlgorithm() {
     if(fitnessFunction != nullptr)
         delete fitnessFunction;
     clearPopulation();
+    if(pool != nullptr)
+        delete pool;
+    if(selectionMethod != nullptr)
+        delete selectionMethod;
+    if(cache != nullptr)
+        delete cache;
+    if(checkpoint != nullptr)
+        delete checkpoint;
+    if(telemetry != nullptr)
+        delete telemetry;
 }
 
 void GeneticAlgorithm::setConfig(GAConfig *config) {
@@ -24,6 +56,21 @@ void GeneticAlgorithm::setConfig(GAConfig *config) {
     initialize();
 }
 
+void GeneticAlgorithm::reset(Fitness *fitnessFunction, GAConfig *config) {
+    Fitness *previous = this->fitnessFunction;
+    this->fitnessFunction = fitnessFunction;
+    this->config = config;
+    initialize(); // Chromosomes of the previous problem are regenerated or deleted
+    if(previous != nullptr && previous != fitnessFunction)
+        delete previous;
+}
+
+Fitness* GeneticAlgorithm::releaseFitness() {
+    Fitness *released = fitnessFunction;
+    fitnessFunction = nullptr;
+    return released;
+}
+
 void GeneticAlgorithm::sortPopulation() {
     std::sort(population.begin(), population.end(), [](Chromosome* a, Chromosome* b) {
         return a->fitness > b->fitness; // Sort in descending order
@@ -36,11 +83,84 @@ void GeneticAlgorithm::initialize(){
         std::cerr << "Initialization: Fitness function not set" << std::endl;
         return;
     }
-    clearPopulation();
+    // The initial population is evaluated below, even if the previous run stopped on its deadline
+    stopConditions.clear();
+
+    // Every run with the same seed produces the same results, as all the random
+    // numbers of the algorithm are drawn from the stream of this thread
+    Uniform::setSeed(config->seed);
+
+    // Hardware counters include the evaluation workers created after them
+    if(config->hardwareCounters)
+        profiler.openCounters();
+
+    // Evaluation workers, kept if the number of threads does not change
+    const unsigned int threads = config->threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : config->threads;
+    if(pool != nullptr && pool->size() != threads){
+        delete pool;
+        pool = nullptr;
+    }
+    if(pool == nullptr)
+        pool = new ThreadPool(threads);
+
+    // Evaluations of repeated genotypes are reused. A cache of the same size is cleared instead of allocated
+    const unsigned int cacheSize = fitnessFunction->cacheable() ? config->cacheSize : 0;
+    if(cache != nullptr && cache->getCapacity() != cacheSize){
+        delete cache;
+        cache = nullptr;
+    }
+    if(cache != nullptr)
+        cache->clear();
+    else if(cacheSize > 0)
+        cache = new EvaluationCache(cacheSize);
+
+    // Parent selection strategy, kept with its buffers if the method does not change
+    if(selectionMethod != nullptr && selectionType != config->selection){
+        delete selectionMethod;
+        selectionMethod = nullptr;
+    }
+    selectionType = config->selection;
+    switch (config->selection) {
+        case SELECTION::TOURNAMENT:
+            if(selectionMethod == nullptr)
+                selectionMethod = new TournamentSelection(config->tournamentSize);
+            ((TournamentSelection*) selectionMethod)->setSize(config->tournamentSize);
+            break;
+        case SELECTION::RANK:
+            if(selectionMethod == nullptr)
+                selectionMethod = new RankSelection(config->rankPressure);
+            ((RankSelection*) selectionMethod)->setPressure(config->rankPressure);
+            break;
+        default:
+            if(selectionMethod == nullptr)
+                selectionMethod = new RouletteSelection();
+    }
+
+    evaluations = 0;
+    deltaEvaluations = 0;
+    batchEvaluation = true;
+
+    // All the chromosomes are allocated here. The next generation is copied into the 
+    // offspring slots and then both buffers are swapped, so the evolution does not 
+    // allocate or release chromosomes. The chromosomes of a previous problem are
+    // regenerated in place if the fitness function is of the same class and supports it
+    const bool regenerate = population.size() == config->populationSize && bestChromosome != nullptr
+        && chromosomesSource != nullptr && *chromosomesSource == typeid(*fitnessFunction)
+        && fitnessFunction->regenerateChromosome(population[0]);
+    if(!regenerate)
+        clearPopulation();
     for (unsigned int i = 0; i < config->populationSize; i++) {
-        Chromosome *ch = fitnessFunction->generateChromosome();
-        population.push_back(ch);
+        if(regenerate){ // Same order of random numbers as the allocation
+            if(i > 0)
+                fitnessFunction->regenerateChromosome(population[i]);
+            fitnessFunction->regenerateChromosome(offspring[i]);
+        }else{
+            population.push_back(fitnessFunction->generateChromosome());
+            offspring.push_back(fitnessFunction->generateChromosome());
+        }
     }
+    chromosomesSource = &typeid(*fitnessFunction);
+    evaluate(population);
     sortPopulation(); // Sort the population by fitness best to worse
 
     // Calculate the number of elite individuals
@@ -48,96 +168,188 @@ void GeneticAlgorithm::initialize(){
 
     // This is not a pointer to the best in the population, to avoid losing the best individual
     // during the evolution
-    bestChromosome = fitnessFunction->generateChromosome();
+    if(regenerate)
+        fitnessFunction->regenerateChromosome(bestChromosome);
+    else
+        bestChromosome = fitnessFunction->generateChromosome();
 
     status = STATUS::IDLE;
 }
 
 void GeneticAlgorithm::clearPopulation() {
+    for(Chromosome *ch : population)
+        delete ch;
+    for(Chromosome *ch : offspring)
+        delete ch;
     population.clear();
+    offspring.clear();
+    if(bestChromosome != nullptr){
+        delete bestChromosome;
+        bestChromosome = nullptr;
+    }
+}
+
+void GeneticAlgorithm::evaluate(std::vector<Chromosome*> &individuals) {
+    // Only individuals modified since their last evaluation are evaluated
+    pending.clear();
+    for (unsigned int i = 0; i < individuals.size(); i++) {
+        if(individuals[i]->dirty)
+            pending.push_back(i);
+    }
+
+    // Incremental evaluation is tried first, chromosomes that do not track their
+    // changes or fitness functions without it fall back to the full evaluation
+    pool->parallelFor(pending.size(), [this, &individuals](unsigned int k) {
+        thread_local std::vector<unsigned int> changedGenes; // Reused by each worker
+        Chromosome *ch = individuals[pending[k]];
+        if(ch->getChangedGenes(changedGenes) && fitnessFunction->evaluateDelta(ch, changedGenes))
+            ch->evaluated();
+    });
+    unsigned int remaining = 0;
+    for (unsigned int i : pending) {
+        if(individuals[i]->dirty)
+            pending[remaining++] = i;
+    }
+    deltaEvaluations += pending.size() - remaining;
+    pending.resize(remaining);
+
+    if(cache != nullptr){
+        // Hashes are computed in parallel, but the cache is only accessed from this thread
+        hashes.resize(individuals.size());
+        pool->parallelFor(pending.size(), [this, &individuals](unsigned int k) {
+            hashes[pending[k]] = individuals[pending[k]]->hash();
+        });
+        unsigned int misses = 0;
+        for (unsigned int i : pending) {
+            // A hit only restores the fitness, not the state kept for incremental evaluations,
+            // so evaluated() is not called and the genotype is not taken as the new reference
+            if(hashes[i] != 0 && cache->lookup(hashes[i], individuals[i]))
+                individuals[i]->dirty = false;
+            else
+                pending[misses++] = i;
+        }
+        pending.resize(misses);
+    }
+
+    if(batchEvaluation)
+        evaluateBatches(individuals);
+
+    // Individuals are evaluated concurrently by the pool workers. Only some evaluations
+    // are timed, so the latency histogram does not slow down cheap fitness functions
+    pool->parallelFor(pending.size(), [this, &individuals](unsigned int k) {
+        if(!individuals[pending[k]]->dirty || stopConditions.expired(k)) // Evaluated in a batch, or out of time
+            return;
+        if(k % LATENCY_SAMPLING == 0){
+            const uint64_t begin = Profiler::now();
+            fitnessFunction->evaluate(individuals[pending[k]]);
+            profiler.latency(Profiler::now() - begin);
+        }else{
+            fitnessFunction->evaluate(individuals[pending[k]]);
+        }
+        individuals[pending[k]]->evaluated();
+    });
+    // Individuals skipped after the deadline are still dirty
+    for (unsigned int i : pending) {
+        if(individuals[i]->dirty)
+            continue;
+        evaluations++;
+        if(cache != nullptr && hashes[i] != 0)
+            cache->insert(hashes[i], individuals[i]);
+    }
+}
+
+void GeneticAlgorithm::evaluateBatches(std::vector<Chromosome*> &individuals) {
+    if(pending.empty())
+        return;
+    const unsigned int count = pending.size();
+    const unsigned int blocks = std::min(pool->size(), (count + BATCH_MIN_SIZE - 1) / BATCH_MIN_SIZE);
+    batches.resize(blocks);
+    for (unsigned int b = 0; b < blocks; b++) {
+        batches[b].clear();
+        for (unsigned int k = b * count / blocks; k < (b + 1) * count / blocks; k++)
+            batches[b].push_back(individuals[pending[k]]);
+    }
+
+    std::atomic<unsigned int> declined(0);
+    pool->parallelFor(blocks, [this, &declined](unsigned int b) {
+        if(stopConditions.expired(0))
+            return;
+        const uint64_t begin = Profiler::now();
+        if(!fitnessFunction->evaluateBatch(batches[b])){
+            declined++;
+            return;
+        }
+        profiler.latency((Profiler::now() - begin) / batches[b].size()); // Mean time of the block
+        for(Chromosome *ch : batches[b])
+            ch->evaluated();
+    });
+    if(declined == blocks) // Not implemented, individuals are evaluated one by one from now on
+        batchEvaluation = false;
 }
 
 void GeneticAlgorithm::evaluation() {
+    evaluate(population);
+
+    // The best individual is searched once all the evaluations finished, so
+    // there is no shared state between workers. Individuals not evaluated before
+    // the deadline keep the fitness of their parents, so they are not considered
     long int bestFitnessIndex = -1;
+    double bestFitness = bestFitnessValue;
     for (unsigned int i = 0; i < config->populationSize; i++) {
-        fitnessFunction->evaluate(population[i]);
-        if(population[i]->fitness > bestFitnessValue){
-            std::cout << "New best fitness: " << population[i]->fitness << std::endl;
-            bestFitnessValue = population[i]->fitness;
+        if(!population[i]->dirty && population[i]->fitness > bestFitness){
+            bestFitness = population[i]->fitness;
             bestFitnessIndex = i;
         }
     }
     
     if(bestFitnessIndex != -1){
+        std::lock_guard<std::mutex> lock(bestMutex);
         bestChromosome->clone(population[bestFitnessIndex]);
+        bestFitnessValue = bestFitness;
+        improved = true;
     }else{
         stagnatedGenerations++;
     }
 }
 
-void GeneticAlgorithm::selection() { // Roulette wheel selection
+void GeneticAlgorithm::selection() { // Strategy selected in the configuration
 
     // Keep the best chromosomes
-    std::vector<Chromosome*> newPopulation;
     for (unsigned int i = 0; i < elite; i++) {
-        newPopulation.push_back(population[i]);
-    }
-
-    // Selection requires the fitness values to be positive
-    // Calculate the sum of the shifted fitness values
-    double minFitness = population[population.size() - 1]->fitness;
-    double offset = std::abs(minFitness);
-    double scaledFitness[config->populationSize];
-    double fitnessSum = 0.0;
-    for (unsigned int j = elite; j < config->populationSize; j++) {
-        scaledFitness[j] = population[j]->fitness + offset + 1.0; // Scaling to positive values
-        fitnessSum += scaledFitness[j];
-    }
-
-    // Select the best individuals between the rest of the population
-    unsigned int tries = 0; // Avoid infinite loop (should never happen)
-    while(newPopulation.size() < config->populationSize){
-        const double r = uniform.random(fitnessSum);
-        double sum = 0.0;
-        for (unsigned int j = elite; j < config->populationSize; j++) {
-            sum += scaledFitness[j];
-            if (sum >= r) {
-                // Create new chromosome (already evaluated)
-                Chromosome *ch = fitnessFunction->generateChromosome();
-                ch->clone(population[j]);
-                newPopulation.push_back(ch);
-                break;
-            }
-        }
-        tries++;
-        if(tries > 200){
-            std::cerr << "Selection error" << std::endl;
-            std::cout << "Fitness sum: " << fitnessSum << std::endl;
-            std::cout << "r = " << r << std::endl;
-            std::cout << "Sum: " << sum << std::endl;
-            exit(1);
-        }
+        offspring[i]->clone(population[i]);
     }
 
-    for(unsigned int i = elite; i < config->populationSize; i++){
-        delete population[i];
-        population[i] = newPopulation[i];
+    // Select the rest of the population between the non elite individuals
+    selectionMethod->prepare(population, elite);
+    for (unsigned int i = elite; i < config->populationSize; i++) {
+        // Copy the chromosome (already evaluated) into the slot
+        offspring[i]->clone(population[selectionMethod->select()]);
     }
+
+    std::swap(population, offspring);
 }
 
 void GeneticAlgorithm::crossover() {
-    for (unsigned int i = 0; i < config->populationSize; i++) {
+    crossover(population);
+}
+
+void GeneticAlgorithm::crossover(std::vector<Chromosome*> &individuals) {
+    for (unsigned int i = 0; i < individuals.size(); i++) {
         if (uniform.random() < config->crossoverRate) {
-            unsigned int parent1 = uniform.random(config->populationSize);
-            population[i]->crossover(population[parent1]);
+            unsigned int parent1 = uniform.random(individuals.size());
+            individuals[i]->crossover(individuals[parent1]);
         }
     }
 }
 
 void GeneticAlgorithm::mutation() {
-    for (unsigned int i = 0; i < config->populationSize; i++) {
+    mutation(population);
+}
+
+void GeneticAlgorithm::mutation(std::vector<Chromosome*> &individuals) {
+    for (unsigned int i = 0; i < individuals.size(); i++) {
         if (uniform.random() < config->mutationRate) {
-            population[i]->mutate();
+            individuals[i]->mutate();
         }
     }
 }
@@ -182,71 +394,298 @@ void GeneticAlgorithm::print() {
 }
 
 
-GAResults GeneticAlgorithm::run() {
-    
-    GAResults results(OBJTYPE::SINGLE);
-
-    if(fitnessFunction == nullptr){
-        std::cerr << "Run: Fitness function not set" << std::endl;
-        return results;
+void GeneticAlgorithm::getEmigrants(std::vector<Chromosome*> &emigrants, unsigned int count) {
+    sortPopulation();
+    emigrants.clear();
+    for (unsigned int i = 0; i < count && i < population.size(); i++) {
+        emigrants.push_back(population[i]);
     }
-    if(population.size() == 0){
-        std::cerr << "Population not initialized" << std::endl;
-        return results;
+}
+
+void GeneticAlgorithm::immigrate(const std::vector<const Chromosome*> &immigrants) {
+    // Each immigrant takes the place of the worst individual, if it is better.
+    // The next evaluation updates the best chromosome
+    for (const Chromosome *ch : immigrants) {
+        unsigned int worst = 0;
+        for (unsigned int i = 1; i < population.size(); i++) {
+            if(population[i]->fitness < population[worst]->fitness)
+                worst = i;
+        }
+        if(ch->fitness > population[worst]->fitness)
+            population[worst]->clone(ch);
     }
-    
+}
+
+void GeneticAlgorithm::start() {
     status = STATUS::RUNNING;
-    bestFitnessValue = __DBL_MIN__;
+    {
+        std::lock_guard<std::mutex> lock(bestMutex);
+        bestFitnessValue = -__DBL_MAX__;
+    }
     currentGeneration = 0;
     stagnatedGenerations = 0;
-    unsigned int maxStagationGenerations = config->stagnationWindow*config->maxGenerations;
-    
+    stopConditions.clear(); // The deadline is set once the checkpoint is restored
+    improved = false;
 
     // Start timer
-    auto start = std::chrono::high_resolution_clock::now();
+    startTime = std::chrono::high_resolution_clock::now();
+    profiler.reset();
 
-    while (status == STATUS::RUNNING){
-        
-        // GA steps
-        sortPopulation(); // Sort the population from best to worst fitness
-        selection(); // Select the best individual by roulette wheel method
-        crossover(); // Apply crossover using single point method
-        mutation(); // Perform mutation (all individuals are evaluated here)
-        evaluation(); // Evaluate the new population
+    if(checkpoint != nullptr)
+        delete checkpoint;
+    checkpoint = config->checkpointFile.empty() ? nullptr : new Checkpoint(config->checkpointFile);
+    if(!config->resumeFile.empty() && !restore(config->resumeFile))
+        std::cerr << "Checkpoint: cannot resume from " << config->resumeFile << ", starting a new run" << std::endl;
 
+    if(telemetry != nullptr)
+        delete telemetry;
+    telemetry = config->telemetryFile.empty() ? nullptr : new Telemetry(config->telemetryFile, config->telemetryBinary);
 
-        ///// Check stop conditions ///////
+    // The timeout is counted from the start of the run, including the time restored from the checkpoint
+    stopConditions.start(startTime, config->timeout);
+}
 
-        auto elapsed = std::chrono::high_resolution_clock::now() - start; // Time in milliseconds
-        if (std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() > config->timeout) {
-            //*config->outputStream << "Timeout reached (" << config->timeout << "s)" << std::endl;
-            status = STATUS::TIMEOUT;
-            break;
-        }
+void GeneticAlgorithm::step() {
+    // GA steps
+    uint64_t t = Profiler::now();
+    sortPopulation(); // Sort the population from best to worst fitness
+    t = profiler.phase(PHASE::SORT, t);
+    selection(); // Select the individuals of the next generation
+    t = profiler.phase(PHASE::SELECTION, t);
+    crossover(); // Apply crossover using single point method
+    t = profiler.phase(PHASE::CROSSOVER, t);
+    mutation(); // Perform mutation (all individuals are evaluated here)
+    t = profiler.phase(PHASE::MUTATION, t);
+    evaluation(); // Evaluate the new population
+    profiler.phase(PHASE::EVALUATION, t);
+
+    endGeneration();
+}
 
-        if(stagnatedGenerations > maxStagationGenerations){
-            //*config->outputStream << "Stagnation reached: " << stagnatedGenerations << " generations out of " << config->maxGenerations << " stipulated." << std::endl;
-            status = STATUS::STAGNATED;
-            break;
-        }
+void GeneticAlgorithm::endGeneration() {
+    const unsigned int generation = currentGeneration + 1; // Generations evolved
+    checkStopConditions();
+    saveCheckpoint();
+
+    // Statistics are only computed for the generations that are recorded or reported
+    const bool last = status != STATUS::RUNNING;
+    bool report = telemetry != nullptr || (improved && !improvementCallbacks.empty());
+    for(const auto &callback : generationCallbacks)
+        report = report || last || generation % callback.first == 0;
+    if(report){
+        GenerationStats stats = {};
+        stats.generation = generation;
+        auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
+        stats.elapsed = std::chrono::duration<double, std::milli>(elapsed).count();
+        stats.evaluations = evaluations + deltaEvaluations;
+        recordGeneration(stats);
+        if(telemetry != nullptr)
+            telemetry->record(stats);
+        for(const auto &callback : generationCallbacks)
+            if(last || generation % callback.first == 0)
+                callback.second(stats);
+        if(improved)
+            for(const ProgressCallback &callback : improvementCallbacks)
+                callback(stats);
+    }
+    improved = false;
 
-        currentGeneration++;
-        if(currentGeneration >= config->maxGenerations){
-            //*config->outputStream << "Max generations reached (" << config->maxGenerations << ")" << std::endl;
-            status = STATUS::MAX_GENERATIONS;
-            break;
-        }
+    if(telemetry != nullptr && last)
+        telemetry->close(); // The file is complete when the run returns
+}
+
+void GeneticAlgorithm::onGeneration(unsigned int interval, ProgressCallback callback) {
+    generationCallbacks.push_back(std::make_pair(std::max(interval, 1u), callback));
+}
+
+void GeneticAlgorithm::onImprovement(ProgressCallback callback) {
+    improvementCallbacks.push_back(callback);
+}
+
+void GeneticAlgorithm::recordGeneration(GenerationStats &stats) {
+    double sum = 0.0, squares = 0.0;
+    stats.best = -__DBL_MAX__;
+    for(Chromosome *ch : population){
+        sum += ch->fitness;
+        squares += ch->fitness * ch->fitness;
+        stats.best = std::max(stats.best, ch->fitness);
+    }
+    stats.mean = sum / population.size();
+    stats.deviation = sqrt(std::max(squares / population.size() - stats.mean * stats.mean, 0.0));
+    stats.diversity = diversity();
+}
+
+double GeneticAlgorithm::diversity() {
+    // Distinct genotype hashes, or distinct fitness values for chromosomes without hash
+    std::vector<uint64_t> &keys = genotypes;
+    keys.clear();
+    for(Chromosome *ch : population){
+        uint64_t h = ch->hash();
+        if(h == 0)
+            memcpy(&h, &ch->fitness, sizeof(h));
+        keys.push_back(h);
+    }
+    std::sort(keys.begin(), keys.end());
+    return (double) (std::unique(keys.begin(), keys.end()) - keys.begin()) / keys.size();
+}
+
+bool GeneticAlgorithm::copyBest(Chromosome *target) {
+    std::lock_guard<std::mutex> lock(bestMutex);
+    if(bestChromosome == nullptr || bestFitnessValue == -__DBL_MAX__)
+        return false;
+    target->clone(bestChromosome);
+    return true;
+}
+
+void GeneticAlgorithm::checkStopConditions() { // Same conditions as GeneticAlgorithmT
+    status = stopConditions.check(config, currentGeneration, stagnatedGenerations);
+}
+
+void GeneticAlgorithm::saveCheckpoint() {
+    if(checkpoint == nullptr)
+        return;
+    const bool last = status != STATUS::RUNNING;
+    if(!last && (config->checkpointInterval == 0 || currentGeneration % config->checkpointInterval != 0))
+        return;
+
+    // The state is copied here and written by the checkpoint thread
+    std::vector<uint8_t> &buffer = checkpointBuffer;
+    buffer.clear();
+    serializeValue(buffer, (uint32_t) config->populationSize);
+    serializeValue(buffer, (uint32_t) config->maxGenerations);
+    serializeValue(buffer, config->mutationRate);
+    serializeValue(buffer, config->crossoverRate);
+    serializeValue(buffer, config->elitismRate);
+    serializeValue(buffer, (uint32_t) config->selection);
+    serializeValue(buffer, config->seed);
+
+    uint64_t rngState[4];
+    Uniform::local().getState(rngState);
+    for (int i = 0; i < 4; i++)
+        serializeValue(buffer, rngState[i]);
+    auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    serializeValue(buffer, (int64_t) std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    serializeValue(buffer, (uint32_t) currentGeneration);
+    serializeValue(buffer, (uint32_t) stagnatedGenerations);
+    serializeValue(buffer, (uint64_t) evaluations);
+    serializeValue(buffer, (uint64_t) deltaEvaluations);
+    serializeValue(buffer, bestFitnessValue);
+
+    bool ok = MigrationProtocol::writeChromosome(buffer, bestChromosome);
+    for (unsigned int i = 0; ok && i < population.size(); i++)
+        ok = MigrationProtocol::writeChromosome(buffer, population[i]);
+    writeState(buffer);
+    if(!ok){
+        std::cerr << "Checkpoint: chromosomes cannot be serialized, checkpoints disabled" << std::endl;
+        delete checkpoint;
+        checkpoint = nullptr;
+        return;
+    }
+
+    checkpoint->write(buffer);
+    if(last) // Nothing is lost if the program ends after the run
+        checkpoint->wait();
+}
+
+bool GeneticAlgorithm::restore(const std::string &path) {
+    std::vector<uint8_t> payload;
+    if(!Checkpoint::read(path, payload))
+        return false;
+    const uint8_t *data = payload.data();
+    const uint8_t *end = data + payload.size();
+
+    uint32_t populationSize, maxGenerations, selection, generation, stagnated;
+    double mutationRate, crossoverRate, elitismRate;
+    uint64_t seed, rngState[4], evaluated, deltaEvaluated;
+    int64_t elapsed;
+    double bestFitness;
+    bool ok = deserializeValue(data, end, populationSize) && deserializeValue(data, end, maxGenerations)
+        && deserializeValue(data, end, mutationRate) && deserializeValue(data, end, crossoverRate)
+        && deserializeValue(data, end, elitismRate) && deserializeValue(data, end, selection)
+        && deserializeValue(data, end, seed);
+    for (int i = 0; ok && i < 4; i++)
+        ok = deserializeValue(data, end, rngState[i]);
+    ok = ok && deserializeValue(data, end, elapsed) && deserializeValue(data, end, generation)
+        && deserializeValue(data, end, stagnated) && deserializeValue(data, end, evaluated)
+        && deserializeValue(data, end, deltaEvaluated) && deserializeValue(data, end, bestFitness);
+    if(!ok || populationSize != population.size()){
+        std::cerr << "Checkpoint: population size does not match" << std::endl;
+        return false;
+    }
+    if(mutationRate != config->mutationRate || crossoverRate != config->crossoverRate 
+        || elitismRate != config->elitismRate || selection != (uint32_t) config->selection)
+        std::cerr << "Checkpoint: the run continues with a different configuration" << std::endl;
+
+    {
+        std::lock_guard<std::mutex> lock(bestMutex);
+        ok = MigrationProtocol::readChromosome(data, end, bestChromosome);
+    }
+    for (unsigned int i = 0; ok && i < population.size(); i++)
+        ok = MigrationProtocol::readChromosome(data, end, population[i]);
+    ok = ok && readState(data, end);
+
+    // Restored chromosomes are evaluated again, so the state kept by the fitness function
+    // in the chromosomes is rebuilt
+    evaluate(population);
+    if(!ok)
+        return false;
+
+    Uniform::local().setState(rngState);
+    startTime = std::chrono::high_resolution_clock::now() - std::chrono::milliseconds(elapsed);
+    currentGeneration = generation;
+    stagnatedGenerations = stagnated;
+    {
+        std::lock_guard<std::mutex> lock(bestMutex);
+        bestFitnessValue = bestFitness;
     }
+    evaluations = evaluated;
+    deltaEvaluations = deltaEvaluated;
+    return true;
+}
 
+void GeneticAlgorithm::exportStats(GAResults &results) {
     auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start); // Convert to milliseconds
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - startTime); // Convert to milliseconds
 
-    // Export results
     results.status = status;
-    results.best = bestChromosome;
-    results.bestFitnessValue = bestChromosome->fitness;
     results.generations = currentGeneration;
     results.elapsed = static_cast<int>(duration.count());
+    results.evaluations = evaluations;
+    results.deltaEvaluations = deltaEvaluations;
+    profiler.exportProfile(results.profile);
+    if(cache != nullptr){
+        results.cacheHits = cache->getHits();
+        results.cacheMisses = cache->getMisses();
+    }
+}
 
+GAResults GeneticAlgorithm::getResults() {
+    GAResults results(OBJTYPE::SINGLE);
+    exportStats(results);
+    results.best = bestChromosome;
+    results.bestFitnessValue = bestChromosome->fitness;
     return results;
 }
+
+GAResults GeneticAlgorithm::run() {
+    
+    if(fitnessFunction == nullptr){
+        std::cerr << "Run: Fitness function not set" << std::endl;
+        return GAResults(OBJTYPE::SINGLE);
+    }
+    if(population.size() == 0){
+        std::cerr << "Population not initialized" << std::endl;
+        return GAResults(OBJTYPE::SINGLE);
+    }
+    
+    start();
+    while (status == STATUS::RUNNING){
+        step();
+    }
+
+    return getResults();
+}
+
+RunHandle* GeneticAlgorithm::runAsync() {
+    return new RunHandle(this);
+}
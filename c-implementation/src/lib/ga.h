@@ -14,49 +14,138 @@
 #include <chrono>
 #include <math.h>
 #include <cstring>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <typeinfo>
 
 #include "ga_config.h"
 #include "ga_results.h"
 #include "fitness.h"
+#include "thread_pool.h"
+#include "selection.h"
+#include "evaluation_cache.h"
+#include "checkpoint.h"
+#include "telemetry.h"
+#include "profiler.h"
+#include "migration_protocol.h"
+#include "stop_conditions.h"
+
+#define BATCH_MIN_SIZE 64 // Individuals are not split in smaller blocks for Fitness::evaluateBatch
+
+class RunHandle; // Defined in run_handle.h
 
 
 class GeneticAlgorithm {
     public:
+        // Called from the thread that runs the algorithm, with the statistics of the last generation
+        typedef std::function<void(const GenerationStats &stats)> ProgressCallback;
+
         GeneticAlgorithm();
         GeneticAlgorithm(Fitness *fitnessFunction, GAConfig *config);
         
-        ~GeneticAlgorithm();
+        virtual ~GeneticAlgorithm();
 
         inline Chromosome* getChromosome(int index) { return population[index]; }
 
         GAConfig* getConfig() { return config; }
         void setConfig(GAConfig *config);
+        // Replaces the problem (the previous fitness function is deleted unless it was released). The evaluation
+        // workers are kept. If the fitness function is of the same class and implements Fitness::regenerateChromosome(),
+        // the chromosomes, the cache and the selection buffers are kept too, so many small problems can be solved
+        // with one instance without allocations
+        void reset(Fitness *fitnessFunction, GAConfig *config);
+        Fitness* releaseFitness(); // The caller owns the fitness function from now on (e.g. to keep chromosomes that use it)
 
         virtual GAResults run();
+        // Runs the algorithm in a new thread, the handle is owned by the caller and cancels the run when deleted.
+        // The random stream of the calling thread is copied, so the results are the same as the ones of run()
+        RunHandle* runAsync();
+
+        void onGeneration(unsigned int interval, ProgressCallback callback); // Every interval generations and when the run stops
+        void onImprovement(ProgressCallback callback); // Generations that improve the best fitness (single objective)
+
+        // Steps of run(), used to drive the evolution from outside (e.g. islands)
+        virtual void start(); // Prepares a new run of the initialized population
+        virtual void step(); // Evolves one generation and checks the stop conditions
+        virtual GAResults getResults();
+        inline STATUS getStatus() const { return status; }
+        inline unsigned int getGeneration() const { return currentGeneration; }
+        inline Fitness* getFitnessFunction() { return fitnessFunction; }
+
+        // Runs stop when the timeout expires or the token is cancelled, also in the middle of an evaluation
+        // (the individuals not evaluated yet are ignored). The token is not owned and can be shared by many runs
+        inline void setCancellationToken(CancellationToken *token) { stopConditions.setCancellationToken(token); }
+        // Copies the best individual found so far, it can be called from other threads during the run.
+        // Returns false if there is none yet (or for multi-objective runs)
+        bool copyBest(Chromosome *target);
+
+        // Checkpoints hold the population, counters and random stream of the run. Restoring one
+        // replaces the population, and the run continues from it (start() restores config->resumeFile)
+        bool restore(const std::string &path);
+
+        // Migration, the emigrants remain in the population and immigrants are copied into it
+        virtual void getEmigrants(std::vector<Chromosome*> &emigrants, unsigned int count); // Best individuals
+        virtual void immigrate(const std::vector<const Chromosome*> &immigrants); // Replace the worst individuals
 
         virtual void print();
     
     protected:
         Fitness *fitnessFunction;
         GAConfig *config;
+        ThreadPool *pool; // Workers used to evaluate the population
+        Selection *selectionMethod;
+        SELECTION selectionType; // Method of selectionMethod
+        EvaluationCache *cache;
+        Checkpoint *checkpoint; // Background writer of the checkpoints
+        std::vector<uint8_t> checkpointBuffer;
+        Telemetry *telemetry; // Background writer of the generation records
+        Profiler profiler; // Time of each phase and evaluation latency
+        std::vector<uint64_t> genotypes; // Hashes used to measure the diversity
+        std::vector<uint64_t> hashes; // Genotype hashes of the individuals being evaluated
+        std::vector<unsigned int> pending; // Individuals that still need to be evaluated
+        std::vector<std::vector<Chromosome*>> batches; // Blocks of individuals for Fitness::evaluateBatch
+        bool batchEvaluation; // False once the fitness function declined a batch
         STATUS status;
         std::vector<Chromosome*> population;
+        std::vector<Chromosome*> offspring; // Preallocated slots for the next generation
         unsigned int elite;
-        Uniform uniform;
+        static LocalUniform uniform; // Stream of the thread running the algorithm
         Chromosome *bestChromosome;
+        const std::type_info *chromosomesSource; // Class of the fitness function that generated the chromosomes
         double bestFitnessValue;
+        std::mutex bestMutex; // Guards the best chromosome while it is updated
+        StopConditions stopConditions; // Deadline and cancellation token of the run
+        std::vector<std::pair<unsigned int, ProgressCallback>> generationCallbacks;
+        std::vector<ProgressCallback> improvementCallbacks;
+        bool improved; // The best fitness changed in this generation
 
+        unsigned long evaluations; // Calls to the fitness function
+        unsigned long deltaEvaluations; // Incremental evaluations
         unsigned int currentGeneration;
         unsigned int stagnatedGenerations;
+        std::chrono::high_resolution_clock::time_point startTime;
 
         virtual void sortPopulation();
         void initialize();
         void clearPopulation();
+        void checkStopConditions();
+        void exportStats(GAResults &results);
+        void endGeneration(); // Stop conditions, checkpoints, telemetry and callbacks, shared by the steps
+        virtual void recordGeneration(GenerationStats &stats); // Fitness statistics of the population
+        double diversity();
+        void saveCheckpoint(); // Every checkpointInterval generations and when the run stops
+        virtual void writeState(std::vector<uint8_t> &) {} // Extra state of derived algorithms saved in checkpoints
+        virtual bool readState(const uint8_t *&, const uint8_t *) { return true; }
         
+        void evaluate(std::vector<Chromosome*> &individuals); // Uses the cache and the evaluation workers
+        void evaluateBatches(std::vector<Chromosome*> &individuals); // Pending individuals in blocks, one per thread
         virtual void evaluation();
         virtual void selection();
         void crossover();
+        void crossover(std::vector<Chromosome*> &individuals);
         void mutation();
+        void mutation(std::vector<Chromosome*> &individuals);
 };
 
 #endif // GENETIC_ALGORITHM
@@ -7,12 +7,26 @@ GAConfig::GAConfig() :
                 mutationRate(0.1), 
                 crossoverRate(0.8), 
                 elitismRate(0.1),
+                selection(SELECTION::ROULETTE),
+                tournamentSize(3),
+                rankPressure(1.5),
                 timeout(360),
                 stagnationWindow(0.7),
-                printLevel(0){
+                printLevel(0),
+                threads(1),
+                seed(Uniform::getSeed()),
+                cacheSize(0),
+                islands(1),
+                migrationInterval(10),
+                migrants(2),
+                topology(TOPOLOGY::RING),
+                transport(TRANSPORT::THREADS),
+                checkpointInterval(10),
+                telemetryBinary(false),
+                hardwareCounters(false){
 
-    OutputStream os(STREAM::CONSOLE);
-    outputStream = os.getStream();
+    output = OutputStream(STREAM::CONSOLE);
+    outputStream = output.getStream();
 }
 
 
@@ -57,7 +71,7 @@ void GAConfig::setConfig(int argc, char **argv) {
             }
         } else if (strcmp(argv[i], "-t") == 0) {
             if(i+1 < argc){
-                timeout = atoi(argv[i + 1]);
+                timeout = atof(argv[i + 1]);
             }else{
                 std::cerr << "Error: Timeout not provided" << std::endl;
                 printHelp();
@@ -76,6 +90,144 @@ void GAConfig::setConfig(int argc, char **argv) {
                 std::cerr << "Error: Print level not provided" << std::endl;
                 printHelp();
             }
+        } else if (strcmp(argv[i], "-j") == 0) {
+            if(i+1 < argc){
+                threads = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Number of threads not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-r") == 0) {
+            if(i+1 < argc){
+                seed = strtoull(argv[i + 1], nullptr, 10);
+            }else{
+                std::cerr << "Error: Random seed not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-C") == 0) {
+            if(i+1 < argc){
+                cacheSize = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Cache size not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-S") == 0) {
+            if(i+1 < argc){
+                if (strcmp(argv[i + 1], "roulette") == 0)
+                    selection = SELECTION::ROULETTE;
+                else if (strcmp(argv[i + 1], "tournament") == 0)
+                    selection = SELECTION::TOURNAMENT;
+                else if (strcmp(argv[i + 1], "rank") == 0)
+                    selection = SELECTION::RANK;
+                else{
+                    std::cerr << "Error: Unknown selection method" << std::endl;
+                    printHelp();
+                }
+            }else{
+                std::cerr << "Error: Selection method not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-k") == 0) {
+            if(i+1 < argc){
+                tournamentSize = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Tournament size not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-P") == 0) {
+            if(i+1 < argc){
+                rankPressure = atof(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Rank selection pressure not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-i") == 0) {
+            if(i+1 < argc){
+                islands = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Number of islands not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-M") == 0) {
+            if(i+1 < argc){
+                migrationInterval = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Migration interval not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-n") == 0) {
+            if(i+1 < argc){
+                migrants = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Number of migrants not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-T") == 0) {
+            if(i+1 < argc){
+                if (strcmp(argv[i + 1], "ring") == 0)
+                    topology = TOPOLOGY::RING;
+                else if (strcmp(argv[i + 1], "full") == 0)
+                    topology = TOPOLOGY::FULL;
+                else if (strcmp(argv[i + 1], "random") == 0)
+                    topology = TOPOLOGY::RANDOM;
+                else{
+                    std::cerr << "Error: Unknown migration topology" << std::endl;
+                    printHelp();
+                }
+            }else{
+                std::cerr << "Error: Migration topology not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-X") == 0) {
+            if(i+1 < argc){
+                if (strcmp(argv[i + 1], "threads") == 0)
+                    transport = TRANSPORT::THREADS;
+                else if (strcmp(argv[i + 1], "unix") == 0)
+                    transport = TRANSPORT::UNIX;
+                else if (strcmp(argv[i + 1], "tcp") == 0)
+                    transport = TRANSPORT::TCP;
+                else if (strcmp(argv[i + 1], "shm") == 0)
+                    transport = TRANSPORT::SHARED;
+                else{
+                    std::cerr << "Error: Unknown island transport" << std::endl;
+                    printHelp();
+                }
+            }else{
+                std::cerr << "Error: Island transport not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-K") == 0) {
+            if(i+1 < argc){
+                checkpointFile = argv[i + 1];
+            }else{
+                std::cerr << "Error: Checkpoint file not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-F") == 0) {
+            if(i+1 < argc){
+                checkpointInterval = atoi(argv[i + 1]);
+            }else{
+                std::cerr << "Error: Checkpoint interval not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-R") == 0) {
+            if(i+1 < argc){
+                resumeFile = argv[i + 1];
+            }else{
+                std::cerr << "Error: Checkpoint to resume from not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-L") == 0) {
+            if(i+1 < argc){
+                telemetryFile = argv[i + 1];
+                const size_t n = telemetryFile.size(); // Binary files are named *.bin
+                telemetryBinary = n >= 4 && telemetryFile.compare(n - 4, 4, ".bin") == 0;
+            }else{
+                std::cerr << "Error: Telemetry file not provided" << std::endl;
+                printHelp();
+            }
+        } else if (strcmp(argv[i], "-H") == 0) {
+            hardwareCounters = true;
         } 
     }
 }
@@ -89,5 +241,58 @@ void GAConfig::print()  {
         *outputStream << "  - Stagnation window: " << stagnationWindow*100 << "%" << std::endl;
         *outputStream << "  - Mutation rate: " << mutationRate << std::endl;
         *outputStream << "  - Crossover rate: " << crossoverRate << std::endl;
-        *outputStream << "  - Elitism rate: " << elitismRate << std::endl << std::endl;
+        *outputStream << "  - Elitism rate: " << elitismRate << std::endl;
+        *outputStream << "  - Selection: ";
+        switch (selection) {
+            case SELECTION::ROULETTE:
+                *outputStream << "Roulette" << std::endl;
+                break;
+            case SELECTION::TOURNAMENT:
+                *outputStream << "Tournament (k = " << tournamentSize << ")" << std::endl;
+                break;
+            case SELECTION::RANK:
+                *outputStream << "Rank (pressure = " << rankPressure << ")" << std::endl;
+                break;
+        }
+        *outputStream << "  - Evaluation threads: " << threads << std::endl;
+        *outputStream << "  - Evaluation cache size: " << cacheSize << std::endl;
+        if(islands > 1){
+            *outputStream << "  - Islands: " << islands << " (";
+            switch (topology) {
+                case TOPOLOGY::RING:
+                    *outputStream << "ring";
+                    break;
+                case TOPOLOGY::FULL:
+                    *outputStream << "fully connected";
+                    break;
+                case TOPOLOGY::RANDOM:
+                    *outputStream << "random";
+                    break;
+            }
+            *outputStream << ", " << migrants << " migrants every " << migrationInterval << " generations, ";
+            switch (transport) {
+                case TRANSPORT::THREADS:
+                    *outputStream << "threads";
+                    break;
+                case TRANSPORT::UNIX:
+                    *outputStream << "processes over Unix sockets";
+                    break;
+                case TRANSPORT::TCP:
+                    *outputStream << "processes over loopback TCP";
+                    break;
+                case TRANSPORT::SHARED:
+                    *outputStream << "processes over shared memory";
+                    break;
+            }
+            *outputStream << ")" << std::endl;
+        }
+        if(!checkpointFile.empty())
+            *outputStream << "  - Checkpoints: " << checkpointFile << " (every " << checkpointInterval << " generations)" << std::endl;
+        if(!resumeFile.empty())
+            *outputStream << "  - Resumed from: " << resumeFile << std::endl;
+        if(!telemetryFile.empty())
+            *outputStream << "  - Telemetry: " << telemetryFile << (telemetryBinary ? " (binary)" : " (CSV)") << std::endl;
+        if(hardwareCounters)
+            *outputStream << "  - Hardware counters: enabled" << std::endl;
+        *outputStream << "  - Random seed: " << seed << std::endl << std::endl;
 }
\ No newline at end of file
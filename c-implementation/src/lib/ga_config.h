@@ -3,12 +3,18 @@
 
 #include <iostream>
 #include <cstring>
+#include <string>
+#include <cstdint>
 
 
 #include "./output_stream.h"
 #include "fitness.h"
 #include "./help.h"
+#include "./uniform.h"
+#include "./selection.h"
 
+enum class TOPOLOGY {RING, FULL, RANDOM}; // Migration paths between islands
+enum class TRANSPORT {THREADS, UNIX, TCP, SHARED}; // Islands in threads, or in processes that use sockets or shared memory
 
 class GAConfig {
     
@@ -20,9 +26,27 @@ class GAConfig {
         double mutationRate;
         double crossoverRate;
         double elitismRate;
-        unsigned int timeout;
+        SELECTION selection;
+        unsigned int tournamentSize;
+        double rankPressure; // Expected copies of the best individual in rank selection (1 to 2)
+        double timeout; // Seconds, fractions can be used for millisecond deadlines (0.05 is 50 ms)
         double stagnationWindow;
         int printLevel;
+        unsigned int threads; // Evaluation threads (0 uses all the available cores)
+        uint64_t seed; // Master seed of the random number generators
+        unsigned int cacheSize; // Evaluations kept in the cache (0 disables it)
+        unsigned int islands; // Populations evolved in parallel by IslandGA
+        unsigned int migrationInterval; // Generations between migrations
+        unsigned int migrants; // Individuals sent by each island on every migration
+        TOPOLOGY topology;
+        TRANSPORT transport;
+        std::string checkpointFile; // Checkpoints are written here (empty disables them)
+        unsigned int checkpointInterval; // Generations between checkpoints
+        std::string resumeFile; // Checkpoint the run continues from (empty starts a new run)
+        std::string telemetryFile; // Statistics of each generation are written here (empty disables them)
+        bool telemetryBinary; // Binary records instead of CSV
+        bool hardwareCounters; // Read cycles, instructions and cache misses with perf_event_open (Linux)
+        OutputStream output; // Keeps the stream alive
         std::ostream *outputStream;
 
         void setConfig(int argc, char **argv);
@@ -7,15 +7,25 @@ GAResults::GAResults(OBJTYPE type) {
     generations = 0;
     status = STATUS::IDLE;
     elapsed = 0;
+    evaluations = 0;
+    deltaEvaluations = 0;
+    cacheHits = 0;
+    cacheMisses = 0;
     outputFormat = OUTPUTFORMAT::TXT;
 
-    OutputStream os(STREAM::CONSOLE);
-    outputStream = os.getStream();
+    output = OutputStream(STREAM::CONSOLE);
+    outputStream = output.getStream();
 }
 
 void GAResults::printStats() {
     *outputStream << std::endl << "Generations: " << generations << std::endl;
     *outputStream << "Elapsed time: " << elapsed << "ms" << std::endl;
+    *outputStream << "Evaluations: " << evaluations << std::endl;
+    if(deltaEvaluations > 0)
+        *outputStream << "Incremental evaluations: " << deltaEvaluations << std::endl;
+    if(cacheHits + cacheMisses > 0)
+        *outputStream << "Evaluation cache: " << cacheHits << " hits, " << cacheMisses << " misses" << std::endl;
+    printProfile();
     *outputStream << "Stop condition: ";
     switch (status) {
         case STATUS::IDLE:
@@ -32,13 +42,48 @@ void GAResults::printStats() {
         case STATUS::STAGNATED:
             *outputStream << "Stagnation" << std::endl;
             break;
+        case STATUS::CANCELLED:
+            *outputStream << "Cancelled" << std::endl;
+            break;
         default:
             *outputStream << "Unknown" << std::endl;
     }
 }
 
+void GAResults::printProfile() {
+    if(elapsed > 0)
+        *outputStream << "Evaluations per second: " << (unsigned long) ((evaluations + deltaEvaluations) * 1000.0 / elapsed) << std::endl;
+    if(profile.peakMemory > 0)
+        *outputStream << "Peak memory: " << profile.peakMemory / 1024.0 << " MB" << std::endl;
+
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        total += profile.phaseTime[i];
+    if(total > 0){
+        *outputStream << "Time per phase:" << std::endl;
+        for (unsigned int i = 0; i < PHASE_COUNT; i++) {
+            *outputStream << "  - " << Profile::phaseName(i) << ": " << profile.phaseTime[i] / 1e6 << "ms (" 
+                << (int) (100.0 * profile.phaseTime[i] / total + 0.5) << "%)" << std::endl;
+        }
+    }
+
+    const uint64_t samples = profile.samples();
+    if(samples > 0){
+        *outputStream << "Evaluation latency (" << samples << " samples): p50 " << profile.percentile(0.5) / 1e3 << "us, p90 " 
+            << profile.percentile(0.9) / 1e3 << "us, p99 " << profile.percentile(0.99) / 1e3 << "us" << std::endl;
+    }
+
+    if(profile.hardware){
+        *outputStream << "Hardware counters: " << profile.cycles << " cycles, " << profile.instructions << " instructions (";
+        *outputStream << (profile.cycles > 0 ? (double) profile.instructions / profile.cycles : 0.0) << " per cycle), ";
+        *outputStream << profile.cacheMisses << " cache misses" << std::endl;
+    }
+}
+
 void GAResults::printBest() {
     *outputStream << std::endl << "Best fitness: " << bestFitnessValue << std::endl;
+    if(best == nullptr) // Value chromosomes of GeneticAlgorithmT are not in the results
+        return;
     *outputStream << "Best chromosome:" << std::endl;
     *outputStream << "  - ";
     best->printGenotype();
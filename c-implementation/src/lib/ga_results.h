@@ -9,6 +9,7 @@
 #include "./help.h"
 #include "./output_stream.h"
 #include "chromosome.h"
+#include "profiler.h"
 
 enum class OUTPUTFORMAT {TXT, CSV, SVG, HTML};
 
@@ -17,7 +18,8 @@ enum class STATUS { // Stop condition for the Genetic Algorithm
     RUNNING,
     MAX_GENERATIONS,
     TIMEOUT,
-    STAGNATED
+    STAGNATED,
+    CANCELLED // Stopped with a cancellation token
 };
 
 enum class OBJTYPE {SINGLE, MULTI};
@@ -32,16 +34,24 @@ class GAResults { // Results of the Genetic Algorithm
         std::vector<Chromosome*> paretoFront;
         STATUS status;
         int elapsed;
+        unsigned long evaluations;
+        unsigned long deltaEvaluations;
+        unsigned long cacheHits;
+        unsigned long cacheMisses;
+        Profile profile; // Time of each phase, evaluation latency and hardware counters
+        OutputStream output; // Keeps the stream alive
         std::ostream *outputStream;
         OUTPUTFORMAT outputFormat;
 
         void setConfig(int argc, char **argv);
         void print();
+        inline OBJTYPE getType() const { return type; }
 
     private:
         OBJTYPE type;
 
         void printStats();
+        void printProfile();
         void printBest();
         void printPareto();
         void printCSV();
@@ -0,0 +1,224 @@
+#ifndef GA_TEMPLATE_H
+#define GA_TEMPLATE_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "ga_config.h"
+#include "ga_results.h"
+#include "thread_pool.h"
+#include "selection.h"
+#include "profiler.h"
+#include "stop_conditions.h"
+#include "uniform.h"
+
+/*
+    Genetic algorithm for chromosomes that are value types, stored contiguously in the population.
+    Operators and fitness function are resolved at compile time, so the generation loop can be
+    inlined. The types only need these members (see FixedBitString):
+
+    ChromosomeT (default constructible and copyable):
+        double fitness;
+        bool dirty; // Set by the operators when the genes change
+        void mutate(Uniform &rng);
+        void crossover(ChromosomeT &other, Uniform &rng);
+
+    FitnessT:
+        ChromosomeT generate(Uniform &rng) const;
+        double evaluate(const ChromosomeT &chromosome) const; // Called from the evaluation threads
+
+    The stop conditions (StopConditions, including the deadline checked during the evaluation and the
+    cancellation token), selection methods and evaluation threads are the ones of GeneticAlgorithm,
+    which is still the engine of polymorphic chromosomes (cache, incremental evaluation, islands
+    and checkpoints are only available there).
+*/
+
+template<typename ChromosomeT, typename FitnessT>
+class GeneticAlgorithmT {
+    public:
+        GeneticAlgorithmT(const FitnessT &fitnessFunction, GAConfig *config) :
+            fitnessFunction(fitnessFunction),
+            config(config),
+            tournament(config->tournamentSize),
+            rank(config->rankPressure) {
+
+            Uniform::setSeed(config->seed);
+            Uniform &rng = Uniform::local();
+            pool = new ThreadPool(config->threads);
+            evaluations = 0;
+
+            population.reserve(config->populationSize);
+            for (unsigned int i = 0; i < config->populationSize; i++)
+                population.push_back(fitnessFunction.generate(rng));
+            offspring = population; // Slots of the next generation
+            evaluate();
+            sortPopulation();
+
+            elite = config->elitismRate * (double) config->populationSize;
+            best = population[order[0]];
+            status = STATUS::IDLE;
+        }
+
+        inline void setCancellationToken(CancellationToken *token) { stopConditions.setCancellationToken(token); }
+
+        ~GeneticAlgorithmT() { delete pool; }
+
+        // The evaluation pool is owned by the instance
+        GeneticAlgorithmT(const GeneticAlgorithmT&) = delete;
+        GeneticAlgorithmT& operator=(const GeneticAlgorithmT&) = delete;
+
+        GAResults run() {
+            start();
+            while(status == STATUS::RUNNING)
+                step();
+            return getResults();
+        }
+
+        void start() {
+            status = STATUS::RUNNING;
+            bestFitnessValue = -__DBL_MAX__;
+            currentGeneration = 0;
+            stagnatedGenerations = 0;
+            startTime = std::chrono::high_resolution_clock::now();
+            profiler.reset();
+            stopConditions.start(startTime, config->timeout);
+        }
+
+        void step() {
+            Uniform &rng = Uniform::local();
+            uint64_t t = Profiler::now();
+            sortPopulation();
+            t = profiler.phase(PHASE::SORT, t);
+            switch (config->selection) { // Members of final classes, so select() is not a virtual call
+                case SELECTION::TOURNAMENT:
+                    selection(tournament);
+                    break;
+                case SELECTION::RANK:
+                    selection(rank);
+                    break;
+                default:
+                    selection(roulette);
+            }
+            t = profiler.phase(PHASE::SELECTION, t);
+            for (unsigned int i = 0; i < population.size(); i++) {
+                if(rng.random() < config->crossoverRate)
+                    population[i].crossover(population[(unsigned int) rng.random(population.size())], rng);
+            }
+            t = profiler.phase(PHASE::CROSSOVER, t);
+            for (unsigned int i = 0; i < population.size(); i++) {
+                if(rng.random() < config->mutationRate)
+                    population[i].mutate(rng);
+            }
+            t = profiler.phase(PHASE::MUTATION, t);
+            evaluation();
+            profiler.phase(PHASE::EVALUATION, t);
+
+            checkStopConditions();
+        }
+
+        GAResults getResults() { // The best chromosome is not a Chromosome, it is returned by getBest()
+            GAResults results(OBJTYPE::SINGLE);
+            results.status = status;
+            results.generations = currentGeneration;
+            results.elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - startTime).count());
+            results.evaluations = evaluations;
+            results.bestFitnessValue = best.fitness;
+            profiler.exportProfile(results.profile);
+            return results;
+        }
+
+        inline STATUS getStatus() const { return status; }
+        inline unsigned int getGeneration() const { return currentGeneration; }
+        inline const ChromosomeT& getBest() const { return best; }
+        inline const std::vector<ChromosomeT>& getPopulation() const { return population; }
+
+    private:
+        FitnessT fitnessFunction;
+        GAConfig *config;
+        ThreadPool *pool;
+        Profiler profiler;
+        StopConditions stopConditions;
+        RouletteSelection roulette;
+        TournamentSelection tournament;
+        RankSelection rank;
+        STATUS status;
+        std::vector<ChromosomeT> population;
+        std::vector<ChromosomeT> offspring;
+        std::vector<unsigned int> order; // Population sorted from best to worst fitness
+        std::vector<double> sorted; // Fitness values in that order
+        std::vector<unsigned int> pending;
+        unsigned int elite;
+        ChromosomeT best;
+        double bestFitnessValue;
+        unsigned long evaluations;
+        unsigned int currentGeneration;
+        unsigned int stagnatedGenerations;
+        std::chrono::high_resolution_clock::time_point startTime;
+
+        void sortPopulation() { // Chromosomes are not moved, only their indices are sorted
+            order.resize(population.size());
+            for (unsigned int i = 0; i < order.size(); i++)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+                return population[a].fitness > population[b].fitness;
+            });
+            sorted.resize(order.size());
+            for (unsigned int i = 0; i < order.size(); i++)
+                sorted[i] = population[order[i]].fitness;
+        }
+
+        template<typename SelectionT>
+        void selection(SelectionT &method) {
+            for (unsigned int i = 0; i < elite; i++)
+                offspring[i] = population[order[i]];
+            method.prepare(sorted, elite);
+            for (unsigned int i = elite; i < population.size(); i++)
+                offspring[i] = population[order[method.select()]];
+            population.swap(offspring);
+        }
+
+        void evaluate() {
+            pending.clear();
+            for (unsigned int i = 0; i < population.size(); i++)
+                if(population[i].dirty)
+                    pending.push_back(i);
+            pool->parallelFor(pending.size(), [this](unsigned int k) {
+                if(stopConditions.expired(k)) // Out of time, the chromosome is still dirty
+                    return;
+                ChromosomeT &ch = population[pending[k]];
+                if(k % LATENCY_SAMPLING == 0){
+                    const uint64_t begin = Profiler::now();
+                    ch.fitness = fitnessFunction.evaluate(ch);
+                    profiler.latency(Profiler::now() - begin);
+                }else{
+                    ch.fitness = fitnessFunction.evaluate(ch);
+                }
+                ch.dirty = false;
+            });
+            for (unsigned int i : pending)
+                evaluations += !population[i].dirty;
+        }
+
+        void evaluation() {
+            evaluate();
+            long int bestFitnessIndex = -1;
+            for (unsigned int i = 0; i < population.size(); i++) { // Individuals not evaluated before the deadline are not considered
+                if(!population[i].dirty && population[i].fitness > bestFitnessValue){
+                    bestFitnessValue = population[i].fitness;
+                    bestFitnessIndex = i;
+                }
+            }
+            if(bestFitnessIndex != -1)
+                best = population[bestFitnessIndex];
+            else
+                stagnatedGenerations++;
+        }
+
+        void checkStopConditions() { // Same conditions as GeneticAlgorithm
+            status = stopConditions.check(config, currentGeneration, stagnatedGenerations);
+        }
+};
+
+#endif // GA_TEMPLATE_H
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include "./uniform.h"
+#include "./serialization.h"
 
 class Gene { // Abstract class that models a gene
     public:
@@ -10,9 +11,13 @@ class Gene { // Abstract class that models a gene
         virtual void randomize() = 0;
         virtual void print() const = 0;
 
+        // Needed to send chromosomes to other processes (false if not supported)
+        virtual bool serialize(std::vector<uint8_t> &) const { return false; }
+        virtual bool deserialize(const uint8_t *&, const uint8_t *) { return false; }
+
     protected:
         Gene() = default;
-        Uniform uniform; //RANDOM
+        static LocalUniform uniform; //RANDOM (stream of the calling thread)
 };
 
 #endif // GENE_H
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "island_ga.h"
+
+LocalUniform IslandGA::uniform;
+
+IslandGA::IslandGA(Factory factory, GAConfig *config) {
+    this->config = config;
+    const unsigned int n = std::max(config->islands, 1u);
+
+    // Opened before the islands, so the evaluation workers of every island are counted
+    counters = config->hardwareCounters ? new HardwareCounters() : nullptr;
+    if(counters != nullptr && !counters->available())
+        std::cerr << "Profiler: hardware counters not available" << std::endl;
+
+    // Islands are built in this thread, each one from its own seed
+    for (unsigned int i = 0; i < n; i++) {
+        GAConfig *islandConfig = new GAConfig(*config);
+        islandConfig->seed = config->seed + i;
+        islandConfig->hardwareCounters = false;
+        if(!config->checkpointFile.empty()) // Each island saves its own checkpoints
+            islandConfig->checkpointFile += "." + std::to_string(i);
+        if(!config->resumeFile.empty())
+            islandConfig->resumeFile += "." + std::to_string(i);
+        if(!config->telemetryFile.empty())
+            islandConfig->telemetryFile += "." + std::to_string(i);
+        configs.push_back(islandConfig);
+        islands.push_back(factory(islandConfig));
+    }
+
+    // Mailboxes of the migration paths. Random migrations may use any path
+    mailboxes.assign(n * n, nullptr);
+    for (unsigned int from = 0; from < n; from++) {
+        for (unsigned int to = 0; to < n; to++) {
+            bool connected = false;
+            switch (config->topology) {
+                case TOPOLOGY::RING:
+                    connected = to == (from + 1) % n;
+                    break;
+                case TOPOLOGY::FULL:
+                case TOPOLOGY::RANDOM:
+                    connected = true;
+                    break;
+            }
+            if(connected && from != to) // Room for the migrants of two migrations
+                mailboxes[from * n + to] = new Mailbox(islands[from]->getFitnessFunction(), 2 * config->migrants);
+        }
+    }
+
+    results.assign(n, GAResults(OBJTYPE::SINGLE));
+}
+
+IslandGA::~IslandGA() {
+    for(Mailbox *mb : mailboxes)
+        if(mb != nullptr)
+            delete mb;
+    for(GeneticAlgorithm *ga : islands)
+        delete ga;
+    for(GAConfig *c : configs)
+        delete c;
+    if(counters != nullptr)
+        delete counters;
+}
+
+void IslandGA::evolve(unsigned int island) {
+    GeneticAlgorithm *ga = islands[island];
+
+    // The stream of this thread is reset, so islands do not depend on the thread that runs them
+    Uniform::local().seed(configs[island]->seed, 1);
+
+    std::vector<Chromosome*> emigrants;
+    std::vector<const Chromosome*> immigrants;
+    std::vector<unsigned int> destinations;
+    ga->start();
+    while(ga->getStatus() == STATUS::RUNNING){
+        ga->step();
+        if(ga->getStatus() == STATUS::RUNNING && islands.size() > 1 && config->migrationInterval > 0
+            && ga->getGeneration() % config->migrationInterval == 0)
+            migrate(island, emigrants, immigrants, destinations);
+    }
+    results[island] = ga->getResults();
+}
+
+void IslandGA::getDestinations(TOPOLOGY topology, unsigned int island, unsigned int count, std::vector<unsigned int> &destinations) {
+    destinations.clear();
+    if(count < 2)
+        return;
+    switch (topology) {
+        case TOPOLOGY::RING:
+            destinations.push_back((island + 1) % count);
+            break;
+        case TOPOLOGY::FULL:
+            for (unsigned int to = 0; to < count; to++)
+                if(to != island)
+                    destinations.push_back(to);
+            break;
+        case TOPOLOGY::RANDOM: {
+            unsigned int to = (unsigned int) uniform.random(count - 1);
+            if(to >= island) // Any island but this one
+                to++;
+            destinations.push_back(to);
+            break;
+        }
+    }
+}
+
+void IslandGA::migrate(unsigned int island, std::vector<Chromosome*> &emigrants, std::vector<const Chromosome*> &immigrants, std::vector<unsigned int> &destinations) {
+    const unsigned int n = islands.size();
+
+    // Copies of the best individuals are sent to the neighbours
+    islands[island]->getEmigrants(emigrants, config->migrants);
+    getDestinations(config->topology, island, n, destinations);
+    for(unsigned int to : destinations)
+        for(Chromosome *ch : emigrants)
+            mailbox(island, to)->send(ch);
+
+    // Migrants that arrived since the last migration. Islands do not wait for each other
+    immigrants.clear();
+    for (unsigned int from = 0; from < n; from++)
+        if(mailbox(from, island) != nullptr)
+            mailbox(from, island)->receive(immigrants);
+    islands[island]->immigrate(immigrants);
+    for (unsigned int from = 0; from < n; from++)
+        if(mailbox(from, island) != nullptr)
+            mailbox(from, island)->release();
+}
+
+GAResults IslandGA::run() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint64_t before[3], after[3];
+    const bool counted = counters != nullptr && counters->read(before);
+
+    // This thread runs the first island
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < islands.size(); i++) {
+        threads.emplace_back(&IslandGA::evolve, this, i);
+    }
+    evolve(0);
+    for(std::thread &t : threads)
+        t.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    GAResults total = combine(results);
+    total.elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    if(counted && counters->read(after)){
+        total.profile.hardware = true;
+        total.profile.cycles = after[0] - before[0];
+        total.profile.instructions = after[1] - before[1];
+        total.profile.cacheMisses = after[2] - before[2];
+    }
+    return total;
+}
+
+GAResults IslandGA::combine(const std::vector<GAResults> &results) {
+    // Statistics are added up, except for the generations that are the ones of the longest island
+    GAResults total(results[0].getType());
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < results.size(); i++) {
+        total.generations = std::max(total.generations, results[i].generations);
+        total.elapsed = std::max(total.elapsed, results[i].elapsed);
+        total.evaluations += results[i].evaluations;
+        total.deltaEvaluations += results[i].deltaEvaluations;
+        total.cacheHits += results[i].cacheHits;
+        total.cacheMisses += results[i].cacheMisses;
+        total.profile.merge(results[i].profile);
+        if(results[i].bestFitnessValue > results[best].bestFitnessValue)
+            best = i;
+    }
+
+    if(total.getType() == OBJTYPE::SINGLE){
+        total.status = results[best].status;
+        total.best = results[best].best;
+        total.bestFitnessValue = results[best].bestFitnessValue;
+        return total;
+    }
+
+    // Non dominated individuals of the union of the Pareto fronts
+    std::vector<Chromosome*> paretoFront;
+    for(const GAResults &r : results)
+        paretoFront.insert(paretoFront.end(), r.paretoFront.begin(), r.paretoFront.end());
+    total.status = results[0].status;
+    if(paretoFront.empty())
+        return total;
+    const unsigned int m = paretoFront[0]->objectives.size();
+    std::vector<double> objectives(paretoFront.size() * m);
+    for (unsigned int i = 0; i < paretoFront.size(); i++) {
+        std::copy(paretoFront[i]->objectives.begin(), paretoFront[i]->objectives.end(), objectives.begin() + i*m);
+    }
+    NonDominatedSort sorter;
+    sorter.sort(objectives.data(), paretoFront.size(), m);
+    for (unsigned int k = sorter.frontBegin(0); k < sorter.frontEnd(0); k++) {
+        total.paretoFront.push_back(paretoFront[sorter.getOrder()[k]]);
+    }
+    return total;
+}
+
+void IslandGA::print() {
+    config->print();
+}
@@ -0,0 +1,50 @@
+#ifndef ISLAND_GA_H
+#define ISLAND_GA_H
+
+#include <vector>
+#include <thread>
+#include <functional>
+
+#include "ga.h"
+#include "moga.h"
+#include "mailbox.h"
+#include "nondominated_sort.h"
+
+class IslandGA { // Island model: independent populations evolved in parallel threads that exchange their best individuals
+    public:
+        // The factory builds the algorithm of each island, with its own fitness function (owned by the algorithm)
+        typedef std::function<GeneticAlgorithm*(GAConfig *config)> Factory;
+
+        IslandGA(Factory factory, GAConfig *config);
+        ~IslandGA();
+
+        inline unsigned int size() const { return islands.size(); }
+        inline GeneticAlgorithm* getIsland(unsigned int index) { return islands[index]; }
+        inline void setCancellationToken(CancellationToken *token) { // Stops all the islands
+            for(GeneticAlgorithm *ga : islands)
+                ga->setCancellationToken(token);
+        }
+
+        GAResults run(); // Results of the best island, or the Pareto front of all the islands
+
+        void print();
+
+        // Shared with the multi-process islands
+        static void getDestinations(TOPOLOGY topology, unsigned int island, unsigned int count, std::vector<unsigned int> &destinations);
+        static GAResults combine(const std::vector<GAResults> &results); // Best island or non-dominated union of the fronts
+
+    private:
+        GAConfig *config;
+        std::vector<GAConfig*> configs; // Configuration of each island (differs in the seed)
+        std::vector<GeneticAlgorithm*> islands;
+        std::vector<Mailbox*> mailboxes; // Migration path from island i to j at i*size()+j (nullptr if not connected)
+        std::vector<GAResults> results; // Results of each island
+        HardwareCounters *counters; // Shared by all the islands, as their threads cannot be counted apart
+        static LocalUniform uniform;
+
+        void evolve(unsigned int island); // Runs one island until it stops
+        void migrate(unsigned int island, std::vector<Chromosome*> &emigrants, std::vector<const Chromosome*> &immigrants, std::vector<unsigned int> &destinations);
+        inline Mailbox* mailbox(unsigned int from, unsigned int to) { return mailboxes[from * islands.size() + to]; }
+};
+
+#endif // ISLAND_GA_H
@@ -0,0 +1,37 @@
+#include "mailbox.h"
+
+Mailbox::Mailbox(Fitness *fitnessFunction, unsigned int capacity) : head(0), tail(0), received(0) {
+    // Migrants are copied into preallocated chromosomes, so migrations do not allocate
+    for (unsigned int i = 0; i < capacity; i++) {
+        slots.push_back(fitnessFunction->generateChromosome());
+    }
+}
+
+Mailbox::~Mailbox() {
+    for(Chromosome *ch : slots)
+        delete ch;
+}
+
+bool Mailbox::send(const Chromosome *ch) {
+    const unsigned int t = tail.load(std::memory_order_relaxed);
+    if(slots.empty() || t - head.load(std::memory_order_acquire) == slots.size())
+        return false; // The receiver is late, the migrant is dropped
+    slots[t % slots.size()]->clone(ch);
+    tail.store(t + 1, std::memory_order_release); // Publishes the copy
+    return true;
+}
+
+unsigned int Mailbox::receive(std::vector<const Chromosome*> &received) {
+    const unsigned int h = head.load(std::memory_order_relaxed);
+    const unsigned int t = tail.load(std::memory_order_acquire);
+    for (unsigned int i = h; i != t; i++) {
+        received.push_back(slots[i % slots.size()]);
+    }
+    this->received = t - h;
+    return this->received;
+}
+
+void Mailbox::release() { // Slots can be reused by the sender
+    head.store(head.load(std::memory_order_relaxed) + received, std::memory_order_release);
+    received = 0;
+}
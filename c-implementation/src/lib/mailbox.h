@@ -0,0 +1,27 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <vector>
+#include <atomic>
+#include "chromosome.h"
+#include "fitness.h"
+
+class Mailbox { // Lock-free queue of migrants between one sender and one receiver thread
+    public:
+        Mailbox(Fitness *fitnessFunction, unsigned int capacity); // Slots are allocated here
+        ~Mailbox();
+
+        bool send(const Chromosome *ch); // Copies the chromosome, false if the mailbox is full
+
+        // Appends the waiting chromosomes, which remain valid until release() is called
+        unsigned int receive(std::vector<const Chromosome*> &received);
+        void release();
+
+    private:
+        std::vector<Chromosome*> slots;
+        std::atomic<unsigned int> head; // Next slot to read, only written by the receiver
+        std::atomic<unsigned int> tail; // Next slot to write, only written by the sender
+        unsigned int received; // Slots handed to the receiver and not released yet
+};
+
+#endif // MAILBOX_H
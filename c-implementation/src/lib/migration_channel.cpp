@@ -0,0 +1,131 @@
+#include "migration_channel.h"
+
+#include <new>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#define MAX_QUEUED_OUTPUT (1 << 20) // Bytes waiting to be sent before messages are dropped
+
+SocketChannel::SocketChannel(int fd) : fd(fd), inputOffset(0), outputOffset(0) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+SocketChannel::~SocketChannel() {
+    close(fd);
+}
+
+bool SocketChannel::send(const uint8_t *message, size_t size, bool wait) {
+    if(!wait && output.size() - outputOffset + size > MAX_QUEUED_OUTPUT)
+        return false; // The receiver is late, the message is dropped
+    if(outputOffset == output.size()){
+        output.clear();
+        outputOffset = 0;
+    }
+    output.insert(output.end(), message, message + size);
+    if(!flush())
+        return false;
+    while(wait && hasOutput()){
+        pollfd p = {fd, POLLOUT, 0};
+        if(poll(&p, 1, -1) < 0 && errno != EINTR)
+            return false;
+        if(!flush())
+            return false;
+    }
+    return true;
+}
+
+bool SocketChannel::flush() {
+    while(hasOutput()){
+        ssize_t sent = ::send(fd, output.data() + outputOffset, output.size() - outputOffset, MSG_NOSIGNAL);
+        if(sent < 0){
+            if(errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        outputOffset += sent;
+    }
+    return true;
+}
+
+bool SocketChannel::receive() {
+    // Messages already returned are discarded
+    input.erase(input.begin(), input.begin() + inputOffset);
+    inputOffset = 0;
+    uint8_t buffer[65536];
+    while(true){
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if(received > 0){
+            input.insert(input.end(), buffer, buffer + received);
+            continue;
+        }
+        if(received == 0)
+            return false; // Connection closed
+        if(errno == EINTR)
+            continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+bool SocketChannel::next(MessageHeader &header, const uint8_t *&message) {
+    if(input.size() - inputOffset < sizeof(MessageHeader))
+        return false;
+    std::memcpy(&header, input.data() + inputOffset, sizeof(MessageHeader));
+    const size_t size = sizeof(MessageHeader) + header.size;
+    if(input.size() - inputOffset < size)
+        return false; // Not fully received yet
+    message = input.data() + inputOffset;
+    inputOffset += size;
+    return true;
+}
+
+
+size_t SharedRing::footprint(uint32_t capacity) {
+    return sizeof(SharedRing) + capacity;
+}
+
+SharedRing* SharedRing::create(void *memory, uint32_t capacity) {
+    return new (memory) SharedRing(capacity);
+}
+
+SharedRing::SharedRing(uint32_t capacity) : head(0), tail(0), capacity(capacity) {}
+
+void SharedRing::copyIn(uint32_t position, const uint8_t *bytes, uint32_t size) {
+    // Counters grow without bounds, the buffer wraps around
+    const uint32_t offset = position % capacity;
+    const uint32_t first = std::min(size, capacity - offset);
+    std::memcpy(data() + offset, bytes, first);
+    std::memcpy(data(), bytes + first, size - first);
+}
+
+void SharedRing::copyOut(uint32_t position, uint8_t *bytes, uint32_t size) {
+    const uint32_t offset = position % capacity;
+    const uint32_t first = std::min(size, capacity - offset);
+    std::memcpy(bytes, data() + offset, first);
+    std::memcpy(bytes + first, data(), size - first);
+}
+
+bool SharedRing::write(const std::vector<uint8_t> &message) {
+    const uint32_t size = message.size();
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    if(capacity - (t - head.load(std::memory_order_acquire)) < sizeof(size) + size)
+        return false;
+    copyIn(t, reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+    copyIn(t + sizeof(size), message.data(), size);
+    tail.store(t + sizeof(size) + size, std::memory_order_release); // Publishes the message
+    return true;
+}
+
+bool SharedRing::read(std::vector<uint8_t> &message) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    if(tail.load(std::memory_order_acquire) == h)
+        return false;
+    uint32_t size;
+    copyOut(h, reinterpret_cast<uint8_t*>(&size), sizeof(size));
+    message.resize(size);
+    copyOut(h + sizeof(size), message.data(), size);
+    head.store(h + sizeof(size) + size, std::memory_order_release); // The space can be reused
+    return true;
+}
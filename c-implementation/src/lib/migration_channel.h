@@ -0,0 +1,55 @@
+#ifndef MIGRATION_CHANNEL_H
+#define MIGRATION_CHANNEL_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "migration_protocol.h"
+
+class SocketChannel { // Messages over a stream socket (Unix domain or TCP), used without blocking
+    public:
+        SocketChannel(int fd); // Takes ownership of the socket
+        ~SocketChannel();
+
+        inline int getDescriptor() const { return fd; }
+        inline bool hasOutput() const { return outputOffset < output.size(); }
+
+        // With wait, returns once the message is sent. Otherwise the message is queued (or dropped if
+        // too much output is waiting) and sent by flush()
+        bool send(const uint8_t *message, size_t size, bool wait);
+        inline bool send(const std::vector<uint8_t> &message, bool wait) { return send(message.data(), message.size(), wait); }
+        bool flush(); // Sends the queued output that fits in the socket
+
+        bool receive(); // Reads the available input, false when the peer closed the connection
+        bool next(MessageHeader &header, const uint8_t *&message); // Next complete message, valid until the next receive()
+
+    private:
+        int fd;
+        std::vector<uint8_t> input;
+        size_t inputOffset; // Start of the first message not returned by next()
+        std::vector<uint8_t> output;
+        size_t outputOffset; // Start of the output not sent yet
+};
+
+class SharedRing { // Lock-free queue of messages between two processes, placed in shared memory
+    public:
+        static size_t footprint(uint32_t capacity); // Bytes of shared memory needed
+        static SharedRing* create(void *memory, uint32_t capacity); // Built in place before forking (capacity is a power of 2)
+
+        bool write(const std::vector<uint8_t> &message); // Fails if the message does not fit
+        bool read(std::vector<uint8_t> &message); // Next message, false if empty
+
+    private:
+        std::atomic<uint32_t> head; // Bytes read, only written by the receiver
+        std::atomic<uint32_t> tail; // Bytes written, only written by the sender
+        uint32_t capacity;
+
+        SharedRing(uint32_t capacity);
+        inline uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); } // Buffer placed after the ring
+        void copyIn(uint32_t position, const uint8_t *bytes, uint32_t size);
+        void copyOut(uint32_t position, uint8_t *bytes, uint32_t size);
+};
+
+#endif // MIGRATION_CHANNEL_H
@@ -0,0 +1,150 @@
+#include "migration_protocol.h"
+
+void MigrationProtocol::beginMessage(std::vector<uint8_t> &buffer, MESSAGE type, uint32_t from, uint32_t to) {
+    buffer.clear();
+    MessageHeader header = {(uint32_t) type, from, to, 0};
+    serializeValue(buffer, header);
+}
+
+void MigrationProtocol::endMessage(std::vector<uint8_t> &buffer) {
+    const uint32_t size = buffer.size() - sizeof(MessageHeader);
+    std::memcpy(buffer.data() + offsetof(MessageHeader, size), &size, sizeof(size));
+}
+
+void MigrationProtocol::setDestination(std::vector<uint8_t> &buffer, uint32_t to) {
+    std::memcpy(buffer.data() + offsetof(MessageHeader, to), &to, sizeof(to));
+}
+
+bool MigrationProtocol::writeChromosome(std::vector<uint8_t> &buffer, const Chromosome *ch) {
+    serializeValue(buffer, ch->fitness);
+    serializeValue(buffer, (uint32_t) ch->objectives.size());
+    for(double value : ch->objectives)
+        serializeValue(buffer, value);
+
+    // The genotype is preceded by its size, so it can be checked when reading
+    const size_t sizePosition = buffer.size();
+    serializeValue(buffer, (uint32_t) 0);
+    if(!ch->serialize(buffer))
+        return false;
+    const uint32_t size = buffer.size() - sizePosition - sizeof(uint32_t);
+    std::memcpy(buffer.data() + sizePosition, &size, sizeof(size));
+    return true;
+}
+
+bool MigrationProtocol::readChromosome(const uint8_t *&data, const uint8_t *end, Chromosome *ch) {
+    uint32_t m, size;
+    if(!deserializeValue(data, end, ch->fitness) || !deserializeValue(data, end, m))
+        return false;
+    ch->objectives.resize(m);
+    for (unsigned int j = 0; j < m; j++)
+        if(!deserializeValue(data, end, ch->objectives[j]))
+            return false;
+    if(!deserializeValue(data, end, size) || end - data < (long int) size)
+        return false;
+    const uint8_t *genotypeEnd = data + size;
+    if(!ch->deserialize(data, genotypeEnd) || data != genotypeEnd)
+        return false;
+    return true;
+}
+
+bool MigrationProtocol::writeResults(std::vector<uint8_t> &buffer, const GAResults &results) {
+    serializeValue(buffer, (uint32_t) results.getType());
+    serializeValue(buffer, (uint32_t) results.status);
+    serializeValue(buffer, (uint32_t) results.generations);
+    serializeValue(buffer, (int32_t) results.elapsed);
+    serializeValue(buffer, (uint64_t) results.evaluations);
+    serializeValue(buffer, (uint64_t) results.deltaEvaluations);
+    serializeValue(buffer, (uint64_t) results.cacheHits);
+    serializeValue(buffer, (uint64_t) results.cacheMisses);
+    serializeValue(buffer, results.bestFitnessValue);
+    writeProfile(buffer, results.profile);
+
+    if(results.getType() == OBJTYPE::SINGLE){
+        serializeValue(buffer, (uint32_t) (results.best != nullptr ? 1 : 0));
+        return results.best == nullptr || writeChromosome(buffer, results.best);
+    }
+    serializeValue(buffer, (uint32_t) results.paretoFront.size());
+    for(const Chromosome *ch : results.paretoFront)
+        if(!writeChromosome(buffer, ch))
+            return false;
+    return true;
+}
+
+bool MigrationProtocol::readResults(const uint8_t *&data, const uint8_t *end, GAResults &results, Fitness *fitnessFunction, std::vector<Chromosome*> &chromosomes) {
+    uint32_t type, status, generations, count;
+    int32_t elapsed;
+    uint64_t evaluations, deltaEvaluations, cacheHits, cacheMisses;
+    double bestFitnessValue;
+    if(!deserializeValue(data, end, type) || !deserializeValue(data, end, status)
+        || !deserializeValue(data, end, generations) || !deserializeValue(data, end, elapsed)
+        || !deserializeValue(data, end, evaluations) || !deserializeValue(data, end, deltaEvaluations)
+        || !deserializeValue(data, end, cacheHits) || !deserializeValue(data, end, cacheMisses)
+        || !deserializeValue(data, end, bestFitnessValue))
+        return false;
+    Profile profile;
+    if(!readProfile(data, end, profile) || !deserializeValue(data, end, count))
+        return false;
+
+    results = GAResults((OBJTYPE) type);
+    results.status = (STATUS) status;
+    results.generations = generations;
+    results.elapsed = elapsed;
+    results.evaluations = evaluations;
+    results.deltaEvaluations = deltaEvaluations;
+    results.cacheHits = cacheHits;
+    results.cacheMisses = cacheMisses;
+    results.bestFitnessValue = bestFitnessValue;
+    results.profile = profile;
+
+    for (unsigned int i = 0; i < count; i++) {
+        Chromosome *ch = fitnessFunction->generateChromosome();
+        chromosomes.push_back(ch); // Owned by the caller
+        if(!readChromosome(data, end, ch))
+            return false;
+        if(results.getType() == OBJTYPE::SINGLE)
+            results.best = ch;
+        else
+            results.paretoFront.push_back(ch);
+    }
+    return true;
+}
+
+void MigrationProtocol::writeProfile(std::vector<uint8_t> &buffer, const Profile &profile) {
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        serializeValue(buffer, profile.phaseTime[i]);
+    uint32_t used = 0; // Only the buckets with samples are sent
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+        used += profile.latency[i] > 0;
+    serializeValue(buffer, used);
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++) {
+        if(profile.latency[i] > 0){
+            serializeValue(buffer, (uint32_t) i);
+            serializeValue(buffer, profile.latency[i]);
+        }
+    }
+    serializeValue(buffer, (uint32_t) profile.hardware);
+    serializeValue(buffer, profile.cycles);
+    serializeValue(buffer, profile.instructions);
+    serializeValue(buffer, profile.cacheMisses);
+    serializeValue(buffer, profile.peakMemory);
+}
+
+bool MigrationProtocol::readProfile(const uint8_t *&data, const uint8_t *end, Profile &profile) {
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        if(!deserializeValue(data, end, profile.phaseTime[i]))
+            return false;
+    uint32_t used, hardware;
+    if(!deserializeValue(data, end, used))
+        return false;
+    for (uint32_t k = 0; k < used; k++) {
+        uint32_t i;
+        if(!deserializeValue(data, end, i) || i >= LATENCY_BUCKETS || !deserializeValue(data, end, profile.latency[i]))
+            return false;
+    }
+    if(!deserializeValue(data, end, hardware) || !deserializeValue(data, end, profile.cycles)
+        || !deserializeValue(data, end, profile.instructions) || !deserializeValue(data, end, profile.cacheMisses)
+        || !deserializeValue(data, end, profile.peakMemory))
+        return false;
+    profile.hardware = hardware != 0;
+    return true;
+}
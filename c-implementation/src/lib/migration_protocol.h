@@ -0,0 +1,41 @@
+#ifndef MIGRATION_PROTOCOL_H
+#define MIGRATION_PROTOCOL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "chromosome.h"
+#include "fitness.h"
+#include "ga_results.h"
+#include "serialization.h"
+
+enum class MESSAGE : uint32_t {HELLO, MIGRANTS, RESULTS};
+
+struct MessageHeader { // Every message starts with this header, followed by size bytes of payload
+    uint32_t type;
+    uint32_t from; // Island that sent the message
+    uint32_t to; // Destination island of migrants
+    uint32_t size;
+};
+
+class MigrationProtocol { // Binary encoding of the messages exchanged by island processes
+    public:
+        static void beginMessage(std::vector<uint8_t> &buffer, MESSAGE type, uint32_t from, uint32_t to = 0);
+        static void endMessage(std::vector<uint8_t> &buffer); // Writes the payload size in the header
+        static void setDestination(std::vector<uint8_t> &buffer, uint32_t to);
+
+        // Fitness, objectives and genotype. Fails if the chromosome cannot be serialized
+        static bool writeChromosome(std::vector<uint8_t> &buffer, const Chromosome *ch);
+        static bool readChromosome(const uint8_t *&data, const uint8_t *end, Chromosome *ch);
+
+        // Statistics and best chromosome or Pareto front, that are built with the fitness function
+        static bool writeResults(std::vector<uint8_t> &buffer, const GAResults &results);
+        static bool readResults(const uint8_t *&data, const uint8_t *end, GAResults &results, Fitness *fitnessFunction, std::vector<Chromosome*> &chromosomes);
+
+    private:
+        static void writeProfile(std::vector<uint8_t> &buffer, const Profile &profile);
+        static bool readProfile(const uint8_t *&data, const uint8_t *end, Profile &profile);
+};
+
+#endif // MIGRATION_PROTOCOL_H
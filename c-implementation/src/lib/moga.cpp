@@ -41,93 +41,119 @@ bool MultiObjectiveGA::dominates(const Chromosome &a, const Chromosome &b) {
 }
 
 
-void MultiObjectiveGA::sortPopulation() { // Non-dominated sorting
-    paretoFronts.clear();
-    
-    // Step 1: Calculate domination counts and dominated sets for each chromosome
-    for (unsigned int i = 0; i < population.size(); ++i) {
-        population[i]->dominationCount = 0;
-        population[i]->dominatedChromosomes.clear();
-        for (unsigned int j = 0; j < population.size(); ++j) {
-            if (dominates(*population[i], *population[j])) {
-                population[i]->dominatedChromosomes.push_back(population[j]);
-            } else if (dominates(*population[j], *population[i])) {
-                population[i]->dominationCount++;
-            }
-        }
-        if (population[i]->dominationCount == 0) {
-            if (paretoFronts.empty()) 
-                paretoFronts.emplace_back();  // Create the first front if needed
-            paretoFronts[0].push_back(population[i]);  // Add to the first Pareto front
-        }
+void MultiObjectiveGA::rankIndividuals(const std::vector<Chromosome*> &individuals, unsigned int kept) {
+    // Copy the objectives into a contiguous matrix and sort it by index
+    const unsigned int m = individuals[0]->objectives.size();
+    objectives.resize(individuals.size() * m);
+    for (unsigned int i = 0; i < individuals.size(); i++) {
+        std::copy(individuals[i]->objectives.begin(), individuals[i]->objectives.end(), objectives.begin() + i*m);
     }
+    sorter.sort(objectives.data(), individuals.size(), m);
 
-    // Step 2: Calculate the rest of the fronts
-    unsigned int currentFront = 0;
-    while (!paretoFronts[currentFront].empty()) {
-        std::vector<Chromosome*> nextFront;
-        for (Chromosome *chromosome : paretoFronts[currentFront]) {
-            for (Chromosome *dominated : chromosome->dominatedChromosomes) {
-                dominated->dominationCount--;
-                if (dominated->dominationCount == 0) {
-                    nextFront.push_back(dominated);
-                }
-            }
+    // Crowding distance of the fronts that hold the first kept individuals, the rest are discarded
+    distance.assign(individuals.size(), 0.0);
+    for (unsigned int f = 0; f < sorter.getFrontsCount() && sorter.frontBegin(f) < kept; f++) {
+        crowdingDistance(f, m);
+    }
+}
+
+void MultiObjectiveGA::crowdingDistance(unsigned int f, unsigned int m) {
+    // The front is sorted by each objective in a scratch buffer
+    front.assign(sorter.getOrder().begin() + sorter.frontBegin(f), sorter.getOrder().begin() + sorter.frontEnd(f));
+    const unsigned int last = front.size() - 1;
+    for (unsigned int obj = 0; obj < m; obj++) {
+        const double *column = objectives.data() + obj;
+        std::sort(front.begin(), front.end(), [column, m](unsigned int a, unsigned int b){
+            return column[a*m] < column[b*m];
+        });
+        distance[front[0]] = __DBL_MAX__;
+        distance[front[last]] = __DBL_MAX__;
+
+        const double range = column[front[last]*m] - column[front[0]*m];
+        if(range == 0.0) 
+            continue;
+
+        for (unsigned int i = 1; i < last; i++) {
+            if(distance[front[i]] < __DBL_MAX__)
+                distance[front[i]] += (column[front[i+1]*m] - column[front[i-1]*m]) / range;
         }
-        currentFront++;
-        if(nextFront.empty()) break;
-        paretoFronts.push_back(nextFront);
     }
 }
 
-void MultiObjectiveGA::evaluation() {
-    for (unsigned int i = 0; i < config->populationSize; i++) {
-        fitnessFunction->evaluate(population[i]);
+void MultiObjectiveGA::sortPopulation() { // Non-dominated sorting and crowding distance of the population
+    rankIndividuals(population, population.size());
+    for (unsigned int i = 0; i < population.size(); i++) {
+        rank[i] = sorter.getRank(i);
+        crowding[i] = distance[i];
     }
 }
 
-void MultiObjectiveGA::selection() { // Crowding distance
-    std::vector<Chromosome*> newPopulation;
+void MultiObjectiveGA::evaluation() { // Only the offspring are new individuals
+    evaluate(offspring);
+}
 
-    // Crowding distance calculation
-    for(std::vector<Chromosome*> front : paretoFronts){
-        if(newPopulation.size() + front.size() <= config->populationSize){
-            newPopulation.insert(newPopulation.end(), front.begin(), front.end());
+unsigned int MultiObjectiveGA::crowdedTournament() { 
+    // Binary tournament, the lower front wins and, in the same front, the less crowded one
+    const unsigned int a = (unsigned int) uniform.random(population.size());
+    const unsigned int b = (unsigned int) uniform.random(population.size());
+    if(rank[a] != rank[b])
+        return rank[a] < rank[b] ? a : b;
+    return crowding[a] >= crowding[b] ? a : b;
+}
+
+void MultiObjectiveGA::selection() { // Mating selection, parents are copied into the offspring slots
+    for (unsigned int i = 0; i < config->populationSize; i++) {
+        offspring[i]->clone(population[crowdedTournament()]);
+    }
+}
+
+void MultiObjectiveGA::survival() { // Elitist (mu + lambda) replacement of NSGA-II
+    // Parents and offspring compete together, so a good parent is never lost
+    merged.clear();
+    merged.insert(merged.end(), population.begin(), population.end());
+    merged.insert(merged.end(), offspring.begin(), offspring.end());
+    rankIndividuals(merged, config->populationSize);
+
+    // Fronts are taken in order. The first front that does not fit is truncated,
+    // keeping its less crowded individuals
+    population.clear();
+    offspring.clear();
+    const std::vector<unsigned int> &order = sorter.getOrder();
+    for (unsigned int f = 0; f < sorter.getFrontsCount(); f++) {
+        const unsigned int begin = sorter.frontBegin(f);
+        const unsigned int end = sorter.frontEnd(f);
+        const unsigned int remaining = config->populationSize - population.size();
+        if(sorter.frontSize(f) <= remaining){
+            for (unsigned int k = begin; k < end; k++) {
+                rank[population.size()] = f;
+                crowding[population.size()] = distance[order[k]];
+                population.push_back(merged[order[k]]);
+            }
             continue;
-        } else { // Compute crowding distance for the current front
-            for(unsigned int obj = 0; obj < front[0]->objectives.size(); obj++){
-                std::sort(front.begin(), front.end(), [obj](Chromosome* a, Chromosome* b){
-                    return a->objectives[obj] < b->objectives[obj];
-                });
-                front[0]->crowdingDistance = __DBL_MAX__;
-                front[front.size()-1]->crowdingDistance = __DBL_MAX__;
-                
-                double minObj = front[0]->objectives[obj];
-                double maxObj = front[front.size()-1]->objectives[obj];
-                double range = maxObj - minObj;
-
-                if(range == 0.0) 
-                    continue;
-                
-                for(unsigned int i = 1; i < front.size()-1; i++){ 
-                    front[i]->crowdingDistance += (front[i+1]->objectives[obj] - front[i-1]->objectives[obj]) / range;
+        }
+
+        if(remaining > 0){
+            truncated.assign(order.begin() + begin, order.begin() + end);
+            std::sort(truncated.begin(), truncated.end(), [this](unsigned int a, unsigned int b){
+                return distance[a] > distance[b];
+            });
+            for (unsigned int k = 0; k < truncated.size(); k++) {
+                if(k < remaining){
+                    rank[population.size()] = f;
+                    crowding[population.size()] = distance[truncated[k]];
+                    population.push_back(merged[truncated[k]]);
+                }else{
+                    offspring.push_back(merged[truncated[k]]);
                 }
             }
         }
+        break;
     }
 
-    // Fill the rest of the population with the best individuals
-    std::sort(newPopulation.begin(), newPopulation.end(), [](Chromosome* a, Chromosome* b){
-        return a->crowdingDistance > b->crowdingDistance;
-    });
-
-    for(unsigned int i = newPopulation.size(); i < config->populationSize; i++){
-        newPopulation.push_back(population[i]);
+    // Individuals of the remaining fronts become the slots for the next offspring
+    for (unsigned int k = population.size() + offspring.size(); k < merged.size(); k++) {
+        offspring.push_back(merged[order[k]]);
     }
-    
-    for(unsigned int i = 0; i < config->populationSize; i++){
-        population[i] = newPopulation[i];
-    }    
 }
 
 void MultiObjectiveGA::print() {
@@ -148,77 +174,148 @@ void MultiObjectiveGA::print() {
     }
     if(config->printLevel >= 2){
         std::cout << "Population objectives: " << std::endl;        
-        for (unsigned int i = 0; i < paretoFronts[0].size(); i++) {
+        for (unsigned int i = 0; i < paretoFront.size(); i++) {
             std::cout << "Chromosome " << i << ": " << std::endl;
-            for(unsigned int j = 0; j < paretoFronts[0][i]->objectives.size(); j++){
-                std::cout << "    Objective " << j << ": " << paretoFronts[0][i]->objectives[j] << std::endl;
+            for(unsigned int j = 0; j < paretoFront[i]->objectives.size(); j++){
+                std::cout << "    Objective " << j << ": " << paretoFront[i]->objectives[j] << std::endl;
             }
         }
     }
     if(config->printLevel >= 3){
         std::cout << "Population genes: " << std::endl;
-        for (unsigned int i = 0; i < paretoFronts[0].size(); i++) {
-            paretoFronts[0][i]->printGenotype();
-            paretoFronts[0][i]->printPhenotype();
+        for (unsigned int i = 0; i < paretoFront.size(); i++) {
+            paretoFront[i]->printGenotype();
+            paretoFront[i]->printPhenotype();
         }
     }
 }
 
-GAResults MultiObjectiveGA::run() { // Try to avoid overriding this method
-    GAResults results(OBJTYPE::MULTI);
+void MultiObjectiveGA::getEmigrants(std::vector<Chromosome*> &emigrants, unsigned int count) {
+    count = std::min(count, (unsigned int) population.size());
+    candidates.resize(population.size());
+    for (unsigned int i = 0; i < population.size(); i++) {
+        candidates[i] = i;
+    }
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [this](unsigned int a, unsigned int b){
+        if(rank[a] != rank[b])
+            return rank[a] < rank[b];
+        return crowding[a] > crowding[b];
+    });
+    emigrants.clear();
+    for (unsigned int k = 0; k < count; k++) {
+        emigrants.push_back(population[candidates[k]]);
+    }
+}
 
-    if (fitnessFunction == nullptr) {
-        std::cerr << "Run: Fitness function not set" << std::endl;
-        return results;
+void MultiObjectiveGA::immigrate(const std::vector<const Chromosome*> &immigrants) {
+    if(immigrants.empty())
+        return;
+    for (const Chromosome *ch : immigrants) {
+        unsigned int worst = 0;
+        for (unsigned int i = 1; i < population.size(); i++) {
+            if(rank[i] > rank[worst] || (rank[i] == rank[worst] && crowding[i] < crowding[worst]))
+                worst = i;
+        }
+        population[worst]->clone(ch);
+        rank[worst] = 0; // Not replaced again by the next immigrants
+        crowding[worst] = __DBL_MAX__;
     }
+    sortPopulation(); // Fronts including the immigrants
+}
 
-    if (population.size() == 0) {
-        std::cerr << "Population not initialized" << std::endl;
-        return results;
+void MultiObjectiveGA::start() {
+    rank.resize(config->populationSize);
+    crowding.resize(config->populationSize);
+    sortPopulation(); // Replaced by the ones of the checkpoint if the run is resumed
+    GeneticAlgorithm::start();
+}
+
+void MultiObjectiveGA::writeState(std::vector<uint8_t> &buffer) {
+    // Crowding distances come from the last survival, where they were computed with the offspring
+    for (unsigned int i = 0; i < population.size(); i++) {
+        serializeValue(buffer, (uint32_t) rank[i]);
+        serializeValue(buffer, crowding[i]);
     }
+}
 
-    status = STATUS::RUNNING;
-    currentGeneration = 0;
-    
-    // Start the timer
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    while(status == STATUS::RUNNING) {
+bool MultiObjectiveGA::readState(const uint8_t *&data, const uint8_t *end) {
+    for (unsigned int i = 0; i < population.size(); i++) {
+        uint32_t r;
+        if(!deserializeValue(data, end, r) || !deserializeValue(data, end, crowding[i]))
+            return false;
+        rank[i] = r;
+    }
+    return true;
+}
 
-        // GA steps
-        sortPopulation();
-        selection();
-        crossover();
-        mutation();
-        evaluation();
+void MultiObjectiveGA::step() {
+    // GA steps (NSGA-II)
+    uint64_t t = Profiler::now();
+    selection(); // Crowded tournament
+    t = profiler.phase(PHASE::SELECTION, t);
+    crossover(offspring);
+    t = profiler.phase(PHASE::CROSSOVER, t);
+    mutation(offspring);
+    t = profiler.phase(PHASE::MUTATION, t);
+    evaluation(); // Evaluate the offspring
+    t = profiler.phase(PHASE::EVALUATION, t);
+    if(!stopConditions.isInterrupted()){ // Offspring not evaluated before the deadline are discarded with their generation
+        survival(); // Best of parents and offspring
+        profiler.phase(PHASE::SORT, t); // Non dominated sorting and crowding
+    }
 
+    endGeneration();
+}
 
-        ///// Check stop conditions ///////
+void MultiObjectiveGA::recordGeneration(GenerationStats &stats) {
+    double sum = 0.0, squares = 0.0;
+    stats.best = __DBL_MAX__; // Objectives are minimized
+    for(unsigned int i = 0; i < population.size(); i++){
+        const double value = population[i]->objectives.empty() ? 0.0 : population[i]->objectives[0];
+        sum += value;
+        squares += value * value;
+        stats.best = std::min(stats.best, value);
+        if(rank[i] == 0)
+            stats.frontSize++;
+    }
+    stats.mean = sum / population.size();
+    stats.deviation = sqrt(std::max(squares / population.size() - stats.mean * stats.mean, 0.0));
+    stats.diversity = diversity();
+}
 
-        auto elapsed = std::chrono::high_resolution_clock::now() - start; // Time in milliseconds
-        if (std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() > config->timeout) {
-            //*config->outputStream << "Timeout reached (" << config->timeout << "s)" << std::endl;
-            status = STATUS::TIMEOUT;
-            break;
-        }
+GAResults MultiObjectiveGA::getResults() {
+    GAResults results(OBJTYPE::MULTI);
+    exportStats(results);
 
-        currentGeneration++;
-        if(currentGeneration >= config->maxGenerations){
-            //*config->outputStream << "Max generations reached (" << config->maxGenerations << ")" << std::endl;
-            status = STATUS::MAX_GENERATIONS;
-            break;
-        }
+    // Pareto front of the last generation
+    paretoFront.clear();
+    for(unsigned int i = 0; i < population.size(); i++){
+        if(rank[i] == 0)
+            paretoFront.push_back(population[i]);
     }
+    results.paretoFront = paretoFront;
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start); // Convert to milliseconds
+    return results;
+}
 
-    results.status = status;
-    results.paretoFront = paretoFronts[0];
-    results.generations = currentGeneration;
-    results.elapsed = static_cast<int>(duration.count());
+GAResults MultiObjectiveGA::run() { // Try to avoid overriding this method
+    
+    if (fitnessFunction == nullptr) {
+        std::cerr << "Run: Fitness function not set" << std::endl;
+        return GAResults(OBJTYPE::MULTI);
+    }
+
+    if (population.size() == 0) {
+        std::cerr << "Population not initialized" << std::endl;
+        return GAResults(OBJTYPE::MULTI);
+    }
 
+    start();
+    while(status == STATUS::RUNNING) {
+        step();
+    }
 
+    GAResults results = getResults();
 
     // Debug dominated function
     /*
@@ -243,4 +340,4 @@ GAResults MultiObjectiveGA::run() { // Try to avoid overriding this method
     
 
     return results;
-}
\ No newline at end of file
+}
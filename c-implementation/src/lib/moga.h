@@ -2,6 +2,7 @@
 #define MULTI_OBJECTIVE_GA_H
 
 #include "./ga.h"
+#include "./nondominated_sort.h"
 
 class MultiObjectiveGA : public GeneticAlgorithm {
     public:
@@ -9,16 +10,38 @@ class MultiObjectiveGA : public GeneticAlgorithm {
         MultiObjectiveGA() : GeneticAlgorithm() {}
 
         GAResults run() override;
+        void start() override;
+        void step() override;
+        GAResults getResults() override;
+
+        void getEmigrants(std::vector<Chromosome*> &emigrants, unsigned int count) override; // Least crowded of the first fronts
+        void immigrate(const std::vector<const Chromosome*> &immigrants) override; // Replace the most crowded of the last fronts
 
         void print() override;
 
-    private:
-        std::vector<std::vector<Chromosome*>> paretoFronts;
+    protected:
+        NonDominatedSort sorter;
+        std::vector<double> objectives; // Objectives of the ranked individuals as a flat matrix
+        std::vector<double> distance; // Crowding distance of the ranked individuals
+        std::vector<unsigned int> front; // Scratch buffer of the crowding distance
+        std::vector<Chromosome*> merged; // Parents and offspring
+        std::vector<unsigned int> truncated;
+        std::vector<unsigned int> candidates; // Emigrants selection
+        std::vector<unsigned int> rank; // Front of each individual of the population
+        std::vector<double> crowding; // Crowding distance of each individual of the population
+        std::vector<Chromosome*> paretoFront; // Result of the last run
 
         bool dominates(const Chromosome &a, const Chromosome &b);
+        void rankIndividuals(const std::vector<Chromosome*> &individuals, unsigned int kept); // Crowding only for the first kept
+        void crowdingDistance(unsigned int front, unsigned int m);
+        unsigned int crowdedTournament();
         void sortPopulation() override;
         void evaluation() override;
         void selection() override;
+        void survival();
+        void recordGeneration(GenerationStats &stats) override; // First objective and size of the first front
+        void writeState(std::vector<uint8_t> &buffer) override; // Fronts and crowding of the population
+        bool readState(const uint8_t *&data, const uint8_t *end) override;
 };
 
 
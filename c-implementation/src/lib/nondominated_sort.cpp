@@ -0,0 +1,111 @@
+#include "nondominated_sort.h"
+
+bool NonDominatedSort::dominates(const double *a, const double *b, unsigned int m) {
+    bool at_least_one_better = false;
+    for(unsigned int i = 0; i < m; i++){
+        if(a[i] > b[i])
+            return false;
+        if(a[i] < b[i])
+            at_least_one_better = true;
+    }
+    return at_least_one_better;
+}
+
+void NonDominatedSort::sort(const double *objectives, unsigned int count, unsigned int m) {
+    rank.resize(count);
+    order.resize(count);
+    frontStart.clear();
+    frontStart.push_back(0);
+    if(count == 0)
+        return;
+
+    // Lexicographic sort, so an individual can only be dominated by the ones before it
+    sorted.resize(count);
+    for(unsigned int i = 0; i < count; i++)
+        sorted[i] = i;
+    std::sort(sorted.begin(), sorted.end(), [objectives, m](unsigned int a, unsigned int b) {
+        const double *pa = objectives + (size_t) a*m;
+        const double *pb = objectives + (size_t) b*m;
+        for(unsigned int k = 0; k < m; k++){
+            if(pa[k] != pb[k])
+                return pa[k] < pb[k];
+        }
+        return a < b;
+    });
+
+    if(m == 2)
+        sortTwoObjectives(objectives, count);
+    else
+        sortEfficient(objectives, count, m);
+
+    // Group the individuals by front (counting sort, keeps the lexicographic order inside each front)
+    unsigned int fronts = 0;
+    for(unsigned int i = 0; i < count; i++)
+        fronts = std::max(fronts, rank[i] + 1);
+    frontStart.assign(fronts + 1, 0);
+    for(unsigned int i = 0; i < count; i++)
+        frontStart[rank[i] + 1]++;
+    for(unsigned int f = 0; f < fronts; f++)
+        frontStart[f + 1] += frontStart[f];
+    frontTail.assign(fronts, 0);
+    for(unsigned int f = 0; f < fronts; f++)
+        frontTail[f] = frontStart[f];
+    for(unsigned int s = 0; s < count; s++){
+        const unsigned int i = sorted[s];
+        order[frontTail[rank[i]]++] = i;
+    }
+}
+
+void NonDominatedSort::sortTwoObjectives(const double *objectives, unsigned int count) {
+    // Sweep in O(N log N). Individuals come sorted by the first objective, so the one being
+    // processed is dominated by a front if and only if the lowest second objective of the 
+    // front is not greater than its own. These minimums do not decrease from one front to 
+    // the next, so the first front that does not dominate it is found by binary search
+    frontMin.clear();
+    for(unsigned int s = 0; s < count; s++){
+        const unsigned int i = sorted[s];
+        const double *p = objectives + (size_t) i*2;
+        if(s > 0){ // Duplicated individuals do not dominate each other
+            const double *q = objectives + (size_t) sorted[s-1]*2;
+            if(p[0] == q[0] && p[1] == q[1]){
+                rank[i] = rank[sorted[s-1]];
+                continue;
+            }
+        }
+        const unsigned int front = std::upper_bound(frontMin.begin(), frontMin.end(), p[1]) - frontMin.begin();
+        if(front == frontMin.size())
+            frontMin.push_back(p[1]);
+        else
+            frontMin[front] = p[1];
+        rank[i] = front;
+    }
+}
+
+void NonDominatedSort::sortEfficient(const double *objectives, unsigned int count, unsigned int m) {
+    // Efficient non-dominated sort with sequential search (ENS-SS). Each individual is compared
+    // against the fronts in order, starting from the last individual added to each front, and
+    // it is placed in the first front where no one dominates it
+    frontTail.clear();
+    previous.resize(count);
+    for(unsigned int s = 0; s < count; s++){
+        const unsigned int i = sorted[s];
+        const double *p = objectives + (size_t) i*m;
+        unsigned int front = 0;
+        for(; front < frontTail.size(); front++){
+            bool dominated = false;
+            for(long int q = frontTail[front]; q != -1; q = previous[q]){
+                if(dominates(objectives + (size_t) q*m, p, m)){
+                    dominated = true;
+                    break;
+                }
+            }
+            if(!dominated)
+                break;
+        }
+        if(front == frontTail.size())
+            frontTail.push_back(-1);
+        previous[i] = frontTail[front];
+        frontTail[front] = i;
+        rank[i] = front;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef NONDOMINATED_SORT_H
+#define NONDOMINATED_SORT_H
+
+#include <vector>
+#include <algorithm>
+
+class NonDominatedSort { // Sorts a flat matrix of objectives (all minimized) into Pareto fronts
+    public:
+        // The objectives of individual i are objectives[i*m .. i*m+m-1]
+        void sort(const double *objectives, unsigned int count, unsigned int m);
+
+        inline unsigned int getFrontsCount() const { return frontStart.size() - 1; }
+        inline unsigned int frontBegin(unsigned int front) const { return frontStart[front]; }
+        inline unsigned int frontEnd(unsigned int front) const { return frontStart[front + 1]; }
+        inline unsigned int frontSize(unsigned int front) const { return frontStart[front + 1] - frontStart[front]; }
+        inline const std::vector<unsigned int>& getOrder() const { return order; } // Individuals grouped by front
+        inline unsigned int getRank(unsigned int i) const { return rank[i]; } // Front of individual i (0 is the Pareto front)
+
+        static bool dominates(const double *a, const double *b, unsigned int m);
+
+    private:
+        std::vector<unsigned int> order;
+        std::vector<unsigned int> frontStart; // Front f is order[frontStart[f], frontStart[f+1])
+        std::vector<unsigned int> rank;
+
+        // Scratch buffers, kept between calls
+        std::vector<unsigned int> sorted; // Lexicographic order of the individuals
+        std::vector<double> frontMin; // Two objectives: lowest second objective of each front
+        std::vector<long int> frontTail; // More objectives: last individual added to each front
+        std::vector<long int> previous; // More objectives: previous individual of the same front
+
+        void sortTwoObjectives(const double *objectives, unsigned int count);
+        void sortEfficient(const double *objectives, unsigned int count, unsigned int m);
+};
+
+#endif // NONDOMINATED_SORT_H
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 
 enum class STREAM {CONSOLE, FILE, NONE};
@@ -18,7 +19,7 @@ public:
     }
 };
 
-class OutputStream {
+class OutputStream { // Copies share the file, which stays open while any of them exists
     public:
         OutputStream() : type(STREAM::NONE) {}
         OutputStream(std::string filename) : type(STREAM::FILE), filename(filename) {}
@@ -28,22 +29,18 @@ class OutputStream {
             if(type == STREAM::CONSOLE)
                 return &std::cout;
             if(type == STREAM::FILE){
-                fileStream.open(filename);
-                return &fileStream;
+                if(!fileStream)
+                    fileStream = std::make_shared<std::ofstream>(filename);
+                return fileStream.get();
             }
+            static NullStream nullStream; // Not owned by any instance, so it is always valid
             return &nullStream;
         }
-        
-        ~OutputStream() {
-            if(type == STREAM::FILE)
-                fileStream.close();
-        }
 
     private:
         STREAM type;
         std::string filename;
-        std::ofstream fileStream;
-        NullStream nullStream;
+        std::shared_ptr<std::ofstream> fileStream;
 };
 
 #endif // OUTPUT_STREAM_H
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "permutation_chromosome.h"
+
+PermutationChromosome::PermutationChromosome(unsigned int length, double mutProb, PERMCROSSOVER crossoverType, PERMMUTATION mutationType) :
+    Chromosome(mutProb),
+    length(length),
+    order(length),
+    tracked(false),
+    crossoverType(crossoverType),
+    mutationType(mutationType) {
+    randomize();
+}
+
+void PermutationChromosome::randomize() { // Fisher-Yates shuffle
+    for (unsigned int i = 0; i < length; i++)
+        order[i] = i;
+    for (unsigned int i = length; i > 1; i--)
+        std::swap(order[i - 1], order[(unsigned int) uniform.random(i)]);
+    edges.clear();
+    dirty = true;
+    tracked = false;
+}
+
+void PermutationChromosome::swap(unsigned int i, unsigned int j) {
+    if(i == j)
+        return;
+    if(i > j)
+        std::swap(i, j);
+    if(length >= 3){ // With less elements all the orders are the same cycle
+        const unsigned int x = order[i], y = order[j];
+        if(j == i + 1){
+            replaceEdge(prev(i), x, prev(i), y);
+            replaceEdge(y, next(j), x, next(j));
+        }else if(i == 0 && j == length - 1){ // Adjacent through the end of the order
+            replaceEdge(prev(j), y, prev(j), x);
+            replaceEdge(x, next(i), y, next(i));
+        }else{
+            replaceEdge(prev(i), x, prev(i), y);
+            replaceEdge(x, next(i), y, next(i));
+            replaceEdge(prev(j), y, prev(j), x);
+            replaceEdge(y, next(j), x, next(j));
+        }
+    }
+    std::swap(order[i], order[j]);
+    dirty = true;
+}
+
+void PermutationChromosome::invert(unsigned int i, unsigned int j) {
+    if(i == j)
+        return;
+    if(i > j)
+        std::swap(i, j);
+    if(!(i == 0 && j == length - 1)){ // Reversing the whole order gives the same cycle
+        // Inner edges are kept in the opposite direction, only the ends of the segment change
+        const unsigned int a = prev(i), b = order[i], c = order[j], d = next(j);
+        replaceEdge(a, b, a, c);
+        replaceEdge(c, d, b, d);
+    }
+    std::reverse(order.begin() + i, order.begin() + j + 1);
+    dirty = true;
+}
+
+void PermutationChromosome::mutate() {
+    if(mutProb <= 0.0 || length < 2)
+        return;
+    // Positions that start a move are found with the geometric distribution of the gaps
+    // between them, as in BitStringChromosome::mutate()
+    const double logq = mutProb < 1.0 ? log(1.0 - mutProb) : 0.0;
+    double pos = mutProb < 1.0 ? floor(log(1.0 - uniform.random()) / logq) : 0.0;
+    while(pos < (double) length){
+        const unsigned int i = (unsigned int) pos;
+        unsigned int j = (unsigned int) uniform.random(length - 1);
+        if(j >= i)
+            j++;
+        if(mutationType == PERMMUTATION::SWAP)
+            swap(i, j);
+        else
+            invert(i, j);
+        pos += 1.0 + (mutProb < 1.0 ? floor(log(1.0 - uniform.random()) / logq) : 0.0);
+    }
+}
+
+void PermutationChromosome::crossover(Chromosome* other) {
+    PermutationChromosome *otherCh = (PermutationChromosome*) other;
+    if(length < 2)
+        return;
+    switch (crossoverType) {
+        case PERMCROSSOVER::OX:
+            orderCrossover(otherCh);
+            break;
+        case PERMCROSSOVER::PMX:
+            partiallyMappedCrossover(otherCh);
+            break;
+        case PERMCROSSOVER::ERX:
+            edgeRecombination(otherCh);
+            break;
+    }
+}
+
+void PermutationChromosome::replaced(const std::vector<unsigned int> &child) {
+    if(child == order)
+        return;
+    order = child;
+    edges.clear();
+    dirty = true;
+    tracked = false;
+}
+
+void PermutationChromosome::orderCrossover(PermutationChromosome* other) {
+    // Each child keeps a segment of one parent and the rest of the elements in the order
+    // they have in the other parent, starting after the segment
+    unsigned int a = (unsigned int) uniform.random(length);
+    unsigned int b = (unsigned int) uniform.random(length);
+    if(a > b)
+        std::swap(a, b);
+
+    thread_local std::vector<unsigned int> child1, child2;
+    thread_local std::vector<uint8_t> inSegment;
+    auto build = [this, a, b](const std::vector<unsigned int> &p1, const std::vector<unsigned int> &p2, std::vector<unsigned int> &child) {
+        child.resize(length);
+        inSegment.assign(length, 0);
+        for (unsigned int k = a; k <= b; k++) {
+            child[k] = p1[k];
+            inSegment[p1[k]] = 1;
+        }
+        unsigned int pos = b + 1 == length ? 0 : b + 1;
+        for (unsigned int t = 0, k = pos; t < length; t++, k = k + 1 == length ? 0 : k + 1) {
+            if(!inSegment[p2[k]]){
+                child[pos] = p2[k];
+                pos = pos + 1 == length ? 0 : pos + 1;
+            }
+        }
+    };
+    build(order, other->order, child1);
+    build(other->order, order, child2);
+    replaced(child1);
+    other->replaced(child2);
+}
+
+void PermutationChromosome::partiallyMappedCrossover(PermutationChromosome* other) {
+    // Each child gets a segment of one parent, the rest comes from the other parent and the
+    // elements repeated in the segment are replaced following the mapping between both segments
+    unsigned int a = (unsigned int) uniform.random(length);
+    unsigned int b = (unsigned int) uniform.random(length);
+    if(a > b)
+        std::swap(a, b);
+
+    thread_local std::vector<unsigned int> child1, child2, position;
+    thread_local std::vector<uint8_t> inSegment;
+    auto build = [this, a, b](const std::vector<unsigned int> &p1, const std::vector<unsigned int> &p2, std::vector<unsigned int> &child) {
+        child.resize(length);
+        position.resize(length);
+        inSegment.assign(length, 0);
+        for (unsigned int k = 0; k < length; k++)
+            position[p1[k]] = k;
+        for (unsigned int k = a; k <= b; k++) {
+            child[k] = p1[k];
+            inSegment[p1[k]] = 1;
+        }
+        for (unsigned int k = 0; k < length; k++) {
+            if(k >= a && k <= b)
+                continue;
+            unsigned int v = p2[k];
+            while(inSegment[v])
+                v = p2[position[v]];
+            child[k] = v;
+        }
+    };
+    build(order, other->order, child1);
+    build(other->order, order, child2);
+    replaced(child1);
+    other->replaced(child2);
+}
+
+void PermutationChromosome::edgeRecombination(PermutationChromosome* other) {
+    // Table with the (up to 4) neighbours of each element in both parents
+    thread_local std::vector<unsigned int> table, count;
+    table.resize(4 * length);
+    count.assign(length, 0);
+    for (const PermutationChromosome *parent : {(const PermutationChromosome*) this, (const PermutationChromosome*) other}) {
+        for (unsigned int i = 0; i < length; i++) {
+            const unsigned int c = parent->order[i];
+            for (unsigned int nb : {parent->prev(i), parent->next(i)}) {
+                bool found = false;
+                for (unsigned int k = 0; k < count[c]; k++)
+                    found |= table[4*c + k] == nb;
+                if(!found && nb != c)
+                    table[4*c + count[c]++] = nb;
+            }
+        }
+    }
+
+    // Each child starts from the first element of a parent and continues with the neighbour
+    // that has fewer neighbours left, or with a random element when there are none
+    thread_local std::vector<unsigned int> child1, child2, neighbours, left, remaining, where;
+    auto build = [this](unsigned int current, std::vector<unsigned int> &child) {
+        child.resize(length);
+        neighbours = table;
+        left = count;
+        remaining.resize(length);
+        where.resize(length);
+        for (unsigned int i = 0; i < length; i++)
+            remaining[i] = where[i] = i;
+        unsigned int size = length;
+        for (unsigned int k = 0; k < length; k++) {
+            child[k] = current;
+            const unsigned int last = remaining[--size]; // Visited elements are moved to the end
+            remaining[where[current]] = last;
+            where[last] = where[current];
+            for (unsigned int n = 0; n < left[current]; n++) {
+                const unsigned int nb = neighbours[4*current + n];
+                for (unsigned int m = 0; m < left[nb]; m++) {
+                    if(neighbours[4*nb + m] == current){
+                        neighbours[4*nb + m] = neighbours[4*nb + --left[nb]];
+                        break;
+                    }
+                }
+            }
+            if(size == 0)
+                break;
+            unsigned int nextElement = remaining[(unsigned int) uniform.random(size)];
+            unsigned int fewest = 5;
+            for (unsigned int n = 0; n < left[current]; n++) {
+                const unsigned int nb = neighbours[4*current + n];
+                if(left[nb] < fewest){
+                    fewest = left[nb];
+                    nextElement = nb;
+                }
+            }
+            current = nextElement;
+        }
+    };
+    build(order[0], child1);
+    build(other->order[0], child2);
+    replaced(child1);
+    other->replaced(child2);
+}
+
+void PermutationChromosome::clone(const Chromosome* other) {
+    const PermutationChromosome *otherCh = (const PermutationChromosome*) other;
+    length = otherCh->length; // The order may have another length
+    mutProb = otherCh->mutProb;
+    crossoverType = otherCh->crossoverType;
+    mutationType = otherCh->mutationType;
+    order = otherCh->order;
+    edges = otherCh->edges;
+    tracked = otherCh->tracked;
+    fitness = other->fitness;
+    objectives = other->objectives;
+    dirty = other->dirty;
+}
+
+uint64_t PermutationChromosome::hash() const {
+    uint64_t h = length;
+    for (unsigned int i = 0; i < length; i++)
+        h = hashCombine(h, order[i]);
+    return h == 0 ? 1 : h; // 0 is reserved
+}
+
+bool PermutationChromosome::getChangedGenes(std::vector<unsigned int> &changed) const {
+    if(!tracked)
+        return false;
+    changed = edges;
+    return true;
+}
+
+void PermutationChromosome::evaluated() { // The current order is the new reference
+    edges.clear();
+    tracked = true;
+    dirty = false;
+}
+
+bool PermutationChromosome::serialize(std::vector<uint8_t> &buffer) const {
+    serializeValue(buffer, (uint32_t) length);
+    for (unsigned int i = 0; i < length; i++)
+        serializeValue(buffer, (uint32_t) order[i]);
+    return true;
+}
+
+bool PermutationChromosome::deserialize(const uint8_t *&data, const uint8_t *end) {
+    uint32_t n;
+    if(!deserializeValue(data, end, n) || n != length)
+        return false;
+    std::vector<uint8_t> seen(length, 0);
+    for (unsigned int i = 0; i < length; i++) {
+        uint32_t value;
+        if(!deserializeValue(data, end, value) || value >= length || seen[value])
+            return false; // Not a permutation
+        seen[value] = 1;
+        order[i] = value;
+    }
+    edges.clear();
+    tracked = false;
+    dirty = true;
+    return true;
+}
+
+void PermutationChromosome::printGenotype() const {
+    std::cout << "Genotype: ";
+    for (unsigned int i = 0; i < length; i++)
+        std::cout << order[i] << " ";
+    std::cout << std::endl;
+}
+
+void PermutationChromosome::printPhenotype() const {
+    std::cout << "Phenotype: ";
+    for (unsigned int i = 0; i < length; i++)
+        std::cout << order[i] << (i + 1 < length ? " -> " : "");
+    std::cout << std::endl;
+}
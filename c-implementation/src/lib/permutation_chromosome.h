@@ -0,0 +1,68 @@
+#ifndef PERMUTATION_CHROMOSOME_H
+#define PERMUTATION_CHROMOSOME_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <math.h>
+#include "chromosome.h"
+
+enum class PERMCROSSOVER {OX, PMX, ERX};
+enum class PERMMUTATION {SWAP, INVERSION};
+
+class PermutationChromosome : public Chromosome { // Ordering of the integers 0..n-1, e.g. a closed tour of n cities
+    public:
+        PermutationChromosome(unsigned int length, double mutProb,
+            PERMCROSSOVER crossoverType = PERMCROSSOVER::OX, PERMMUTATION mutationType = PERMMUTATION::INVERSION);
+
+        std::string getName() const override { return "Permutation"; }
+
+        void mutate() override; // Each position starts a swap or inversion move with probability mutProb
+        void crossover(Chromosome* other) override; // Uses the operator selected in the constructor
+        void clone(const Chromosome* other) override;
+        uint64_t hash() const override;
+        // Instead of positions, the changes are the edges of the cyclic order that were replaced since the
+        // last evaluation, as groups of 4 elements (a, b, c, d): edge (a, b) was replaced by edge (c, d).
+        // Only the moves are tracked, after a crossover the chromosome has to be evaluated again
+        bool getChangedGenes(std::vector<unsigned int> &changed) const override;
+        void evaluated() override;
+        bool serialize(std::vector<uint8_t> &buffer) const override;
+        bool deserialize(const uint8_t *&data, const uint8_t *end) override;
+
+        void orderCrossover(PermutationChromosome* other); // OX
+        void partiallyMappedCrossover(PermutationChromosome* other); // PMX
+        void edgeRecombination(PermutationChromosome* other); // ERX, keeps the adjacencies of the parents
+
+        // Moves mark the chromosome as modified
+        void swap(unsigned int i, unsigned int j); // Exchanges the elements at positions i and j
+        void invert(unsigned int i, unsigned int j); // Reverses the positions from i to j (2-opt move)
+
+        void randomize();
+
+        inline unsigned int size() const { return length; }
+        inline unsigned int get(unsigned int i) const { return order[i]; }
+        inline const unsigned int* data() const { return order.data(); }
+
+        void printGenotype() const override;
+        void printPhenotype() const override;
+
+    protected:
+        unsigned int length;
+        std::vector<unsigned int> order;
+        std::vector<unsigned int> edges; // Edges replaced by the moves since the last evaluation
+        bool tracked; // False until the first evaluation or after a crossover or randomization
+        PERMCROSSOVER crossoverType;
+        PERMMUTATION mutationType;
+
+        inline unsigned int prev(unsigned int i) const { return order[i == 0 ? length - 1 : i - 1]; }
+        inline unsigned int next(unsigned int i) const { return order[i + 1 == length ? 0 : i + 1]; }
+        inline void replaceEdge(unsigned int a, unsigned int b, unsigned int c, unsigned int d) {
+            edges.push_back(a);
+            edges.push_back(b);
+            edges.push_back(c);
+            edges.push_back(d);
+        }
+        void replaced(const std::vector<unsigned int> &child); // Sets the result of a crossover
+};
+
+#endif // PERMUTATION_CHROMOSOME_H
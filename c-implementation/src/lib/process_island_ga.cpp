@@ -0,0 +1,347 @@
+#include "process_island_ga.h"
+
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define RING_CAPACITY (1 << 16) // Bytes of each shared memory migration path
+#define RING_STRIDE ((SharedRing::footprint(RING_CAPACITY) + 63) & ~((size_t) 63)) // Rings do not share cache lines
+
+ProcessIslandGA::ProcessIslandGA(IslandGA::Factory factory, GAConfig *config) {
+    this->factory = factory;
+    this->config = config;
+    count = std::max(config->islands, 1u);
+    shared = nullptr;
+    sharedSize = 0;
+
+    // Minimal instance, this process does not evolve a population
+    localConfig = new GAConfig(*config);
+    localConfig->populationSize = 1;
+    localConfig->threads = 1;
+    localConfig->cacheSize = 0;
+    localConfig->checkpointFile.clear();
+    localConfig->resumeFile.clear();
+    localConfig->telemetryFile.clear();
+    localConfig->hardwareCounters = false;
+    local = factory(localConfig);
+}
+
+ProcessIslandGA::~ProcessIslandGA() {
+    for(Chromosome *ch : chromosomes)
+        delete ch;
+    delete local;
+    delete localConfig;
+    if(shared != nullptr)
+        munmap(shared, sharedSize);
+}
+
+SharedRing* ProcessIslandGA::ring(unsigned int from, unsigned int to) {
+    return reinterpret_cast<SharedRing*>((uint8_t*) shared + (from * count + to) * RING_STRIDE);
+}
+
+int ProcessIslandGA::connectLoopback(unsigned short port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(fd < 0 || connect(fd, (sockaddr*) &address, sizeof(address)) < 0)
+        return -1;
+    int flag = 1; // Migrants are sent as soon as they are written
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    return fd;
+}
+
+void ProcessIslandGA::work(unsigned int island, int fd) {
+    GAConfig *islandConfig = new GAConfig(*config);
+    islandConfig->seed = config->seed + island; // Same seeds and checkpoints as the islands in threads
+    if(!config->checkpointFile.empty())
+        islandConfig->checkpointFile += "." + std::to_string(island);
+    if(!config->resumeFile.empty())
+        islandConfig->resumeFile += "." + std::to_string(island);
+    if(!config->telemetryFile.empty())
+        islandConfig->telemetryFile += "." + std::to_string(island);
+    GeneticAlgorithm *ga = factory(islandConfig);
+    Uniform::local().seed(islandConfig->seed, 1);
+
+    SocketChannel channel(fd);
+    std::vector<uint8_t> message;
+    if(config->transport == TRANSPORT::TCP){ // Connections are accepted in any order
+        MigrationProtocol::beginMessage(message, MESSAGE::HELLO, island);
+        MigrationProtocol::endMessage(message);
+        channel.send(message, true);
+    }
+
+    std::vector<Chromosome*> emigrants;
+    std::vector<const Chromosome*> immigrants;
+    std::vector<unsigned int> destinations;
+    std::vector<Chromosome*> slots; // Chromosomes the immigrants are read into
+    std::vector<uint8_t> inbox;
+    bool migrate = count > 1 && config->migrationInterval > 0;
+
+    ga->start();
+    while(ga->getStatus() == STATUS::RUNNING){
+        ga->step();
+        if(ga->getStatus() != STATUS::RUNNING || !migrate || ga->getGeneration() % config->migrationInterval != 0)
+            continue;
+
+        // Emigrants are encoded once and sent to every destination
+        ga->getEmigrants(emigrants, config->migrants);
+        MigrationProtocol::beginMessage(message, MESSAGE::MIGRANTS, island);
+        serializeValue(message, (uint32_t) emigrants.size());
+        for(Chromosome *ch : emigrants){
+            if(!MigrationProtocol::writeChromosome(message, ch)){
+                std::cerr << "Island " << island << ": chromosomes cannot be serialized, migration disabled" << std::endl;
+                migrate = false;
+                break;
+            }
+        }
+        if(!migrate)
+            continue;
+        MigrationProtocol::endMessage(message);
+        IslandGA::getDestinations(config->topology, island, count, destinations);
+        for(unsigned int to : destinations){
+            MigrationProtocol::setDestination(message, to);
+            if(config->transport == TRANSPORT::SHARED)
+                ring(island, to)->write(message); // Dropped if the receiver is late
+            else
+                channel.send(message, true);
+        }
+
+        // Migrants that arrived since the last migration
+        immigrants.clear();
+        unsigned int used = 0;
+        auto read = [&](const uint8_t *data, const uint8_t *end) {
+            uint32_t n;
+            if(!deserializeValue(data, end, n))
+                return;
+            for (unsigned int k = 0; k < n; k++) {
+                if(used == slots.size())
+                    slots.push_back(ga->getFitnessFunction()->generateChromosome());
+                if(!MigrationProtocol::readChromosome(data, end, slots[used]))
+                    return;
+                immigrants.push_back(slots[used++]);
+            }
+        };
+        if(config->transport == TRANSPORT::SHARED){
+            for (unsigned int from = 0; from < count; from++)
+                if(from != island)
+                    while(ring(from, island)->read(inbox))
+                        read(inbox.data() + sizeof(MessageHeader), inbox.data() + inbox.size());
+        }else{
+            MessageHeader header;
+            const uint8_t *data;
+            channel.receive();
+            while(channel.next(header, data))
+                if(header.type == (uint32_t) MESSAGE::MIGRANTS)
+                    read(data + sizeof(MessageHeader), data + sizeof(MessageHeader) + header.size);
+        }
+        ga->immigrate(immigrants);
+    }
+
+    MigrationProtocol::beginMessage(message, MESSAGE::RESULTS, island);
+    if(!MigrationProtocol::writeResults(message, ga->getResults()))
+        std::cerr << "Island " << island << ": results cannot be serialized" << std::endl;
+    MigrationProtocol::endMessage(message);
+    channel.send(message, true);
+    std::cout.flush();
+    _exit(0); // Nothing of the launcher is released from the worker
+}
+
+void ProcessIslandGA::route(std::vector<SocketChannel*> &channels, std::vector<GAResults> &results, std::vector<bool> &finished) {
+    // Workers only block when sending to this process, so migrants are queued and
+    // dropped when a worker does not read them
+    std::vector<pollfd> descriptors;
+    std::vector<unsigned int> islands;
+    unsigned int running = 0;
+    for(SocketChannel *channel : channels)
+        if(channel != nullptr)
+            running++;
+    while(running > 0){
+        descriptors.clear();
+        islands.clear();
+        for (unsigned int i = 0; i < count; i++) {
+            if(channels[i] == nullptr)
+                continue;
+            pollfd p = {channels[i]->getDescriptor(), (short) (POLLIN | (channels[i]->hasOutput() ? POLLOUT : 0)), 0};
+            descriptors.push_back(p);
+            islands.push_back(i);
+        }
+        if(poll(descriptors.data(), descriptors.size(), -1) < 0){
+            if(errno == EINTR)
+                continue;
+            break;
+        }
+        for (unsigned int k = 0; k < descriptors.size(); k++) {
+            SocketChannel *channel = channels[islands[k]];
+            if(descriptors[k].revents & POLLOUT)
+                channel->flush();
+            if(!(descriptors[k].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            const bool open = channel->receive();
+            MessageHeader header;
+            const uint8_t *data;
+            while(channel->next(header, data)){
+                if(header.type == (uint32_t) MESSAGE::MIGRANTS && header.to < count && channels[header.to] != nullptr){
+                    channels[header.to]->send(data, sizeof(MessageHeader) + header.size, false);
+                }else if(header.type == (uint32_t) MESSAGE::RESULTS){
+                    const uint8_t *payload = data + sizeof(MessageHeader);
+                    finished[islands[k]] = MigrationProtocol::readResults(payload, payload + header.size, results[islands[k]], local->getFitnessFunction(), chromosomes);
+                }
+            }
+            if(!open){ // The worker finished or failed
+                delete channel;
+                channels[islands[k]] = nullptr;
+                running--;
+            }
+        }
+    }
+}
+
+GAResults ProcessIslandGA::run() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if(shared != nullptr) // Rings of a previous run
+        munmap(shared, sharedSize);
+    shared = nullptr;
+    if(config->transport == TRANSPORT::SHARED){
+        sharedSize = count * count * RING_STRIDE;
+        shared = mmap(nullptr, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if(shared == MAP_FAILED){
+            std::cerr << "Run: shared memory not available" << std::endl;
+            shared = nullptr;
+            return GAResults(OBJTYPE::SINGLE);
+        }
+        for (unsigned int i = 0; i < count * count; i++)
+            SharedRing::create((uint8_t*) shared + i * RING_STRIDE, RING_CAPACITY);
+    }
+
+    // Connections to the workers. Unix sockets are paired before forking, TCP workers connect to
+    // a loopback port
+    std::vector<int> launcherEnds(count, -1), workerEnds(count, -1);
+    int listener = -1;
+    unsigned short port = 0;
+    if(config->transport == TRANSPORT::TCP){
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = 0; // Any free port
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if(listener < 0 || bind(listener, (sockaddr*) &address, sizeof(address)) < 0
+            || listen(listener, count) < 0 || getsockname(listener, (sockaddr*) &address, &length) < 0){
+            std::cerr << "Run: cannot listen on a loopback port" << std::endl;
+            return GAResults(OBJTYPE::SINGLE);
+        }
+        port = ntohs(address.sin_port);
+    }else{
+        for (unsigned int i = 0; i < count; i++) {
+            int pair[2];
+            if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0){
+                std::cerr << "Run: cannot create sockets" << std::endl;
+                return GAResults(OBJTYPE::SINGLE);
+            }
+            launcherEnds[i] = pair[0];
+            workerEnds[i] = pair[1];
+        }
+    }
+
+    std::cout.flush(); // Otherwise the buffered output would be printed by every worker
+    std::vector<pid_t> workers;
+    std::vector<bool> launched(count, false);
+    for (unsigned int i = 0; i < count; i++) {
+        pid_t pid = fork();
+        if(pid == 0){
+            int fd = workerEnds[i];
+            for (unsigned int j = 0; j < count; j++) {
+                if(launcherEnds[j] >= 0)
+                    close(launcherEnds[j]);
+                if(j != i && workerEnds[j] >= 0)
+                    close(workerEnds[j]);
+            }
+            if(listener >= 0){
+                close(listener);
+                fd = connectLoopback(port);
+                if(fd < 0)
+                    _exit(1);
+            }
+            work(i, fd);
+        }
+        if(pid < 0){
+            std::cerr << "Run: cannot launch island " << i << std::endl;
+        }else{
+            workers.push_back(pid);
+            launched[i] = true;
+        }
+        if(workerEnds[i] >= 0)
+            close(workerEnds[i]);
+    }
+
+    std::vector<SocketChannel*> channels(count, nullptr);
+    if(listener >= 0){
+        // Workers tell their island in the first message. Workers that do not connect in time are not waited for
+        for (unsigned int k = 0; k < workers.size(); k++) {
+            pollfd p = {listener, POLLIN, 0};
+            if(poll(&p, 1, 10000) <= 0)
+                break;
+            int fd = accept(listener, nullptr, nullptr);
+            if(fd < 0)
+                break;
+            int flag = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+            SocketChannel *channel = new SocketChannel(fd);
+            MessageHeader header;
+            const uint8_t *data;
+            bool open = true;
+            while(open && !channel->next(header, data)){
+                pollfd q = {fd, POLLIN, 0};
+                poll(&q, 1, -1);
+                open = channel->receive();
+            }
+            if(open && header.type == (uint32_t) MESSAGE::HELLO && header.from < count && channels[header.from] == nullptr)
+                channels[header.from] = channel;
+            else
+                delete channel;
+        }
+        close(listener);
+    }else{
+        for (unsigned int i = 0; i < count; i++) {
+            if(launched[i])
+                channels[i] = new SocketChannel(launcherEnds[i]);
+            else
+                close(launcherEnds[i]);
+        }
+    }
+
+    std::vector<bool> finished(count, false);
+    std::vector<GAResults> results(count, GAResults(OBJTYPE::SINGLE));
+    route(channels, results, finished);
+
+    for(pid_t pid : workers)
+        waitpid(pid, nullptr, 0);
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::vector<GAResults> completed;
+    for (unsigned int i = 0; i < count; i++) {
+        if(finished[i])
+            completed.push_back(results[i]);
+        else
+            std::cerr << "Run: island " << i << " failed" << std::endl;
+    }
+    if(completed.empty())
+        return GAResults(OBJTYPE::SINGLE);
+    GAResults total = IslandGA::combine(completed);
+    total.elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    return total;
+}
+
+void ProcessIslandGA::print() {
+    config->print();
+}
@@ -0,0 +1,40 @@
+#ifndef PROCESS_ISLAND_GA_H
+#define PROCESS_ISLAND_GA_H
+
+#include <vector>
+#include <sys/types.h>
+
+#include "island_ga.h"
+#include "migration_protocol.h"
+#include "migration_channel.h"
+
+class ProcessIslandGA { // Island model with each island in a worker process, for fault isolation and fitness functions that are not thread safe
+    public:
+        // The factory is called in the worker processes. It is also called once in this process,
+        // with a minimal population, to build the chromosomes of the results
+        ProcessIslandGA(IslandGA::Factory factory, GAConfig *config);
+        ~ProcessIslandGA();
+
+        // Launches the workers and routes the migrants until all of them finish. Results of the
+        // workers that fail are ignored
+        GAResults run();
+
+        void print();
+
+    private:
+        IslandGA::Factory factory;
+        GAConfig *config;
+        unsigned int count; // Number of islands
+        GAConfig *localConfig;
+        GeneticAlgorithm *local; // Only used for its fitness function
+        std::vector<Chromosome*> chromosomes; // Received with the results
+        void *shared; // Migration rings of the shared memory transport
+        size_t sharedSize;
+
+        SharedRing* ring(unsigned int from, unsigned int to);
+        void work(unsigned int island, int fd); // Body of the worker processes, does not return
+        void route(std::vector<SocketChannel*> &channels, std::vector<GAResults> &results, std::vector<bool> &finished);
+        int connectLoopback(unsigned short port);
+};
+
+#endif // PROCESS_ISLAND_GA_H
@@ -0,0 +1,160 @@
+#include "profiler.h"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+Profile::Profile() : hardware(false), cycles(0), instructions(0), cacheMisses(0), peakMemory(0) {
+    memset(phaseTime, 0, sizeof(phaseTime));
+    memset(latency, 0, sizeof(latency));
+}
+
+void Profile::merge(const Profile &other) {
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        phaseTime[i] += other.phaseTime[i];
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+        latency[i] += other.latency[i];
+    if(other.hardware){
+        hardware = true;
+        cycles += other.cycles;
+        instructions += other.instructions;
+        cacheMisses += other.cacheMisses;
+    }
+    peakMemory = std::max(peakMemory, other.peakMemory); // Islands in threads share the process, so the largest one is kept
+}
+
+uint64_t Profile::samples() const {
+    uint64_t count = 0;
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+        count += latency[i];
+    return count;
+}
+
+double Profile::percentile(double p) const {
+    const uint64_t count = samples();
+    if(count == 0)
+        return 0.0;
+    const uint64_t rank = (uint64_t) (p * (count - 1)) + 1; // Samples at or below the percentile
+    uint64_t accumulated = 0;
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++) {
+        accumulated += latency[i];
+        if(accumulated >= rank)
+            return bucketValue(i);
+    }
+    return bucketValue(LATENCY_BUCKETS - 1);
+}
+
+unsigned int Profile::bucket(uint64_t ns) {
+    if(ns < 4)
+        return ns;
+    const unsigned int e = 63 - __builtin_clzll(ns); // Power of 2, at least 2
+    return 4 * (e - 1) + ((ns >> (e - 2)) & 3);
+}
+
+double Profile::bucketValue(unsigned int index) {
+    if(index < 4)
+        return index;
+    const unsigned int e = index / 4 + 1;
+    const double width = (double) (1ULL << (e - 2));
+    return (4 + index % 4) * width + width / 2;
+}
+
+const char* Profile::phaseName(unsigned int phase) {
+    static const char *names[PHASE_COUNT] = {"sorting", "selection", "crossover", "mutation", "evaluation"};
+    return phase < PHASE_COUNT ? names[phase] : "unknown";
+}
+
+HardwareCounters::HardwareCounters() {
+    fds[0] = fds[1] = fds[2] = -1;
+#ifdef __linux__
+    const uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < 3; i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.inherit = 1; // Threads created afterwards are counted too
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if(fds[i] < 0){ // Not supported or not allowed (see perf_event_paranoid)
+            for (int j = 0; j < i; j++)
+                close(fds[j]);
+            fds[0] = fds[1] = fds[2] = -1;
+            return;
+        }
+    }
+#endif
+}
+
+HardwareCounters::~HardwareCounters() {
+    for (int i = 0; i < 3; i++)
+        if(fds[i] >= 0)
+            close(fds[i]);
+}
+
+bool HardwareCounters::read(uint64_t values[3]) {
+    for (int i = 0; i < 3; i++)
+        if(fds[i] < 0 || ::read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i]))
+            return false;
+    return true;
+}
+
+Profiler::Profiler() : counters(nullptr) {
+    reset();
+}
+
+Profiler::~Profiler() {
+    if(counters != nullptr)
+        delete counters;
+}
+
+void Profiler::openCounters() {
+    if(counters != nullptr)
+        delete counters;
+    counters = new HardwareCounters();
+    if(!counters->available())
+        std::cerr << "Profiler: hardware counters not available" << std::endl;
+}
+
+void Profiler::reset() {
+    memset(phaseTime, 0, sizeof(phaseTime));
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+        buckets[i].store(0, std::memory_order_relaxed);
+    if(counters != nullptr && !counters->read(baseline)){
+        delete counters;
+        counters = nullptr;
+    }
+}
+
+void Profiler::exportProfile(Profile &profile) {
+    memcpy(profile.phaseTime, phaseTime, sizeof(phaseTime));
+    for (unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+        profile.latency[i] = buckets[i].load(std::memory_order_relaxed);
+    uint64_t values[3];
+    profile.hardware = counters != nullptr && counters->read(values);
+    if(profile.hardware){
+        profile.cycles = values[0] - baseline[0];
+        profile.instructions = values[1] - baseline[1];
+        profile.cacheMisses = values[2] - baseline[2];
+    }
+    profile.peakMemory = peakMemory();
+}
+
+uint64_t Profiler::peakMemory() {
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Bytes in macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
@@ -0,0 +1,80 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#define PHASE_COUNT 5
+#define LATENCY_BUCKETS 256
+#define LATENCY_SAMPLING 8 // One out of this many evaluations is timed
+
+enum class PHASE {SORT, SELECTION, CROSSOVER, MUTATION, EVALUATION}; // Steps of a generation
+
+struct Profile { // Where the time of a run goes, exported to the results
+    Profile();
+
+    uint64_t phaseTime[PHASE_COUNT]; // Nanoseconds spent in each phase
+    uint64_t latency[LATENCY_BUCKETS]; // Histogram of the timed evaluations
+    bool hardware; // Hardware counters were read
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t cacheMisses;
+    uint64_t peakMemory; // Kilobytes of the resident set of the process at its peak (0 if not available)
+
+    void merge(const Profile &other); // Adds up the profile of another island
+    uint64_t samples() const;
+    double percentile(double p) const; // Evaluation latency in nanoseconds (p from 0 to 1)
+
+    // Buckets have 4 steps per power of 2, so values are kept with an error below 25%
+    static unsigned int bucket(uint64_t ns);
+    static double bucketValue(unsigned int index); // Middle of the bucket
+    static const char* phaseName(unsigned int phase);
+};
+
+class HardwareCounters { // Cycles, instructions and cache misses of this thread and the threads it creates later (Linux only)
+    public:
+        HardwareCounters();
+        ~HardwareCounters();
+        inline bool available() const { return fds[0] >= 0; }
+        bool read(uint64_t values[3]);
+
+    private:
+        int fds[3];
+};
+
+class Profiler { // Instrumentation of a run, cheap enough to be always enabled
+    public:
+        Profiler();
+        ~Profiler();
+
+        void reset(); // Called when a run starts
+        // Counters should be opened before the evaluation threads are created, so they are counted
+        void openCounters();
+
+        static inline uint64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Adds the time since begin to the phase and returns the current time, to start the next phase
+        inline uint64_t phase(PHASE p, uint64_t begin) {
+            const uint64_t end = now();
+            phaseTime[(unsigned int) p] += end - begin;
+            return end;
+        }
+
+        // Called by the evaluation workers
+        inline void latency(uint64_t ns) { buckets[Profile::bucket(ns)].fetch_add(1, std::memory_order_relaxed); }
+
+        void exportProfile(Profile &profile);
+        static uint64_t peakMemory(); // Kilobytes, 0 if not available
+
+    private:
+        uint64_t phaseTime[PHASE_COUNT];
+        std::atomic<uint64_t> buckets[LATENCY_BUCKETS];
+        HardwareCounters *counters;
+        uint64_t baseline[3]; // Counters when the run started
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,147 @@
+#include "real_vector_chromosome.h"
+#include <cstring>
+
+RealVectorChromosome::RealVectorChromosome(const std::vector<double> *lower, const std::vector<double> *upper, double mutProb, 
+    double etaCrossover, double etaMutation) :
+    Chromosome(mutProb),
+    values(lower->size()),
+    lower(lower),
+    upper(upper),
+    etaCrossover(etaCrossover),
+    etaMutation(etaMutation) {
+    randomize();
+}
+
+void RealVectorChromosome::randomize() {
+    for (unsigned int i = 0; i < values.size(); i++)
+        values[i] = (*lower)[i] + uniform.random() * ((*upper)[i] - (*lower)[i]);
+    dirty = true;
+}
+
+void RealVectorChromosome::mutate() {
+    if(mutProb <= 0.0 || values.empty())
+        return;
+    // Variables to mutate are found by jumping over the gaps between them (geometric distribution),
+    // as only a few of them change when mutProb is about 1/n
+    const double exponent = 1.0 / (etaMutation + 1.0);
+    const double logq = mutProb < 1.0 ? log(1.0 - mutProb) : -__DBL_MAX__;
+    double pos = mutProb < 1.0 ? floor(log(1.0 - uniform.random()) / logq) : 0.0;
+    while(pos < (double) values.size()){
+        const unsigned int i = (unsigned int) pos;
+        const double range = (*upper)[i] - (*lower)[i];
+        if(range > 0.0){
+            // Perturbation with a polynomial distribution, bounded to the range of the variable
+            const double x = values[i];
+            const double delta1 = (x - (*lower)[i]) / range;
+            const double delta2 = ((*upper)[i] - x) / range;
+            const double u = uniform.random();
+            double deltaq;
+            if(u < 0.5){
+                const double v = 2.0*u + (1.0 - 2.0*u) * pow(1.0 - delta1, etaMutation + 1.0);
+                deltaq = pow(v, exponent) - 1.0;
+            }else{
+                const double v = 2.0*(1.0 - u) + 2.0*(u - 0.5) * pow(1.0 - delta2, etaMutation + 1.0);
+                deltaq = 1.0 - pow(v, exponent);
+            }
+            values[i] = std::min(std::max(x + deltaq * range, (*lower)[i]), (*upper)[i]);
+            dirty = true;
+        }
+        pos += 1.0 + (mutProb < 1.0 ? floor(log(1.0 - uniform.random()) / logq) : 0.0);
+    }
+}
+
+void RealVectorChromosome::crossover(Chromosome* other) {
+    RealVectorChromosome *otherCh = (RealVectorChromosome*) other;
+    const unsigned int n = values.size();
+
+    // Spread factors are computed first, so the loop below has no calls and no branches and
+    // can be vectorized by the compiler
+    const double exponent = 1.0 / (etaCrossover + 1.0);
+    thread_local std::vector<double> beta;
+    beta.resize(n);
+    uint64_t mask = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        if((i & 63) == 0)
+            mask = uniform.bits();
+        if((mask >> (i & 63)) & 1ULL){ // Each variable is recombined with probability 0.5
+            const double u = uniform.random();
+            beta[i] = pow(u <= 0.5 ? 2.0*u : 1.0 / (2.0*(1.0 - u)), exponent);
+        }else{
+            beta[i] = 1.0; // Keeps the values of the parents
+        }
+    }
+
+    double *a = values.data();
+    double *b = otherCh->values.data();
+    const double *lo = lower->data();
+    const double *hi = upper->data();
+    double changed = 0.0;
+    for (unsigned int i = 0; i < n; i++) {
+        const double x1 = a[i];
+        const double x2 = b[i];
+        const double c1 = std::min(std::max(0.5*((1.0 + beta[i])*x1 + (1.0 - beta[i])*x2), lo[i]), hi[i]);
+        const double c2 = std::min(std::max(0.5*((1.0 - beta[i])*x1 + (1.0 + beta[i])*x2), lo[i]), hi[i]);
+        changed += fabs(c1 - x1) + fabs(c2 - x2);
+        a[i] = c1;
+        b[i] = c2;
+    }
+    if(changed != 0.0){
+        dirty = true;
+        otherCh->dirty = true;
+    }
+}
+
+void RealVectorChromosome::clone(const Chromosome* other) {
+    const RealVectorChromosome *otherCh = (const RealVectorChromosome*) other;
+    lower = otherCh->lower; // Bounds of the values, which may have another length
+    upper = otherCh->upper;
+    mutProb = otherCh->mutProb;
+    etaCrossover = otherCh->etaCrossover;
+    etaMutation = otherCh->etaMutation;
+    values = otherCh->values;
+    fitness = other->fitness;
+    objectives = other->objectives;
+    dirty = other->dirty;
+}
+
+uint64_t RealVectorChromosome::hash() const {
+    uint64_t h = values.size();
+    for (unsigned int i = 0; i < values.size(); i++) {
+        uint64_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        h = hashCombine(h, bits);
+    }
+    return h == 0 ? 1 : h; // 0 is reserved
+}
+
+bool RealVectorChromosome::serialize(std::vector<uint8_t> &buffer) const {
+    serializeValue(buffer, (uint32_t) values.size());
+    for (unsigned int i = 0; i < values.size(); i++)
+        serializeValue(buffer, values[i]);
+    return true;
+}
+
+bool RealVectorChromosome::deserialize(const uint8_t *&data, const uint8_t *end) {
+    uint32_t n;
+    if(!deserializeValue(data, end, n) || n != values.size())
+        return false;
+    for (unsigned int i = 0; i < values.size(); i++)
+        if(!deserializeValue(data, end, values[i]))
+            return false;
+    dirty = true;
+    return true;
+}
+
+void RealVectorChromosome::printGenotype() const {
+    std::cout << "Genotype: ";
+    for (unsigned int i = 0; i < values.size(); i++)
+        std::cout << values[i] << " ";
+    std::cout << std::endl;
+}
+
+void RealVectorChromosome::printPhenotype() const {
+    std::cout << "(";
+    for (unsigned int i = 0; i < values.size(); i++)
+        std::cout << values[i] << (i + 1 < values.size() ? ", " : "");
+    std::cout << ")";
+}
@@ -0,0 +1,48 @@
+#ifndef REAL_VECTOR_CHROMOSOME_H
+#define REAL_VECTOR_CHROMOSOME_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <math.h>
+#include "chromosome.h"
+
+class RealVectorChromosome : public Chromosome { // Real variables in a contiguous array, each one within its bounds
+    public:
+        // Bounds are owned by the caller (usually the fitness function) and shared by the chromosomes.
+        // mutProb is the probability of mutating each variable, and the distribution indexes control
+        // how close the offspring stays to the parents (SBX and polynomial mutation)
+        RealVectorChromosome(const std::vector<double> *lower, const std::vector<double> *upper, double mutProb, 
+            double etaCrossover = 15.0, double etaMutation = 20.0);
+
+        std::string getName() const override { return "Real vector"; }
+
+        void mutate() override; // Polynomial mutation
+        void crossover(Chromosome* other) override; // Simulated binary crossover (SBX), both parents are replaced by the offspring
+        void clone(const Chromosome* other) override;
+        uint64_t hash() const override;
+        bool serialize(std::vector<uint8_t> &buffer) const override;
+        bool deserialize(const uint8_t *&data, const uint8_t *end) override;
+
+        void randomize();
+
+        inline unsigned int size() const { return values.size(); }
+        inline double get(unsigned int i) const { return values[i]; }
+        inline void set(unsigned int i, double value) { 
+            values[i] = std::min(std::max(value, (*lower)[i]), (*upper)[i]);
+            dirty = true;
+        }
+        inline const double* data() const { return values.data(); }
+
+        void printGenotype() const override;
+        void printPhenotype() const override;
+
+    protected:
+        std::vector<double> values;
+        const std::vector<double> *lower;
+        const std::vector<double> *upper;
+        double etaCrossover;
+        double etaMutation;
+};
+
+#endif // REAL_VECTOR_CHROMOSOME_H
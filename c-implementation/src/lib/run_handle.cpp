@@ -0,0 +1,42 @@
+#include "run_handle.h"
+
+RunHandle::RunHandle(GeneticAlgorithm *ga) : ga(ga), results(OBJTYPE::SINGLE), finished(false) {
+    ga->setCancellationToken(&token);
+    uint64_t state[4];
+    Uniform::local().getState(state); // Random stream of the calling thread, continued by the run
+    thread = std::thread([this, state]() { run(state); });
+}
+
+RunHandle::~RunHandle() {
+    token.cancel();
+    if(thread.joinable())
+        thread.join();
+    ga->setCancellationToken(nullptr);
+}
+
+void RunHandle::run(const uint64_t state[4]) {
+    Uniform::local().setState(state);
+    GAResults runResults = ga->run();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results = runResults;
+        finished.store(true, std::memory_order_release);
+    }
+    done.notify_all();
+}
+
+bool RunHandle::wait(double timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(timeout < 0.0)
+        done.wait(lock, [this]{ return poll(); });
+    else
+        done.wait_for(lock, std::chrono::duration<double>(timeout), [this]{ return poll(); });
+    return poll();
+}
+
+GAResults RunHandle::get() {
+    wait();
+    if(thread.joinable())
+        thread.join();
+    return results;
+}
@@ -0,0 +1,35 @@
+#ifndef RUN_HANDLE_H
+#define RUN_HANDLE_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "ga.h"
+#include "cancellation.h"
+
+class RunHandle { // Run of a GeneticAlgorithm in its own thread, returned by GeneticAlgorithm::runAsync()
+    public:
+        RunHandle(GeneticAlgorithm *ga); // Installs its own cancellation token in the algorithm
+        ~RunHandle(); // Cancels the run if it did not finish
+
+        inline bool poll() const { return finished.load(std::memory_order_acquire); } // True once the run finished
+        inline void cancel() { token.cancel(); }
+        bool wait(double timeout = -1.0); // Seconds to wait for the end of the run (negative waits forever). True if it finished
+        GAResults get(); // Waits for the end of the run. The chromosomes of the results belong to the algorithm
+        inline bool copyBest(Chromosome *target) { return ga->copyBest(target); } // Best so far, during the run
+
+    private:
+        GeneticAlgorithm *ga;
+        CancellationToken token;
+        GAResults results;
+        std::thread thread;
+        std::atomic<bool> finished;
+        std::mutex mutex;
+        std::condition_variable done;
+
+        void run(const uint64_t state[4]);
+};
+
+#endif // RUN_HANDLE_H
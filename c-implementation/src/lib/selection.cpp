@@ -0,0 +1,71 @@
+#include "selection.h"
+
+LocalUniform Selection::uniform;
+
+void Selection::prepare(const std::vector<Chromosome*> &population, unsigned int from) {
+    values.resize(population.size());
+    for (unsigned int i = 0; i < population.size(); i++)
+        values[i] = population[i]->fitness;
+    prepare(values, from);
+}
+
+void RouletteSelection::prepare(const std::vector<double> &fitness, unsigned int from) {
+    this->from = from;
+    cumulative.resize(fitness.size() - from);
+    if(cumulative.empty())
+        return;
+
+    // Selection requires the fitness values to be positive
+    // Calculate the sum of the shifted fitness values
+    const double minFitness = fitness[fitness.size() - 1];
+    const double offset = std::abs(minFitness);
+    double fitnessSum = 0.0;
+    for (unsigned int j = from; j < fitness.size(); j++) {
+        fitnessSum += fitness[j] + offset + 1.0; // Scaling to positive values
+        cumulative[j - from] = fitnessSum;
+    }
+}
+
+unsigned int RouletteSelection::select() {
+    const double r = uniform.random(cumulative.back());
+    const unsigned int k = std::upper_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin();
+    return from + std::min(k, (unsigned int) cumulative.size() - 1);
+}
+
+void TournamentSelection::prepare(const std::vector<double> &fitness, unsigned int from) {
+    this->from = from;
+    this->to = fitness.size();
+}
+
+unsigned int TournamentSelection::select() {
+    // Population is sorted from best to worst, so the lower index wins
+    unsigned int winner = to - 1;
+    for (unsigned int k = 0; k < size; k++) {
+        const unsigned int candidate = from + (unsigned int) uniform.random(to - from);
+        if(candidate < winner)
+            winner = candidate;
+    }
+    return winner;
+}
+
+void RankSelection::prepare(const std::vector<double> &fitness, unsigned int from) {
+    this->from = from;
+    const unsigned int candidates = fitness.size() - from;
+    if(candidates == cumulative.size())
+        return;
+
+    // Weight of rank k (0 is the best) decreases linearly from pressure to 2-pressure
+    cumulative.resize(candidates);
+    double sum = 0.0;
+    for (unsigned int k = 0; k < candidates; k++) {
+        const double weight = candidates > 1 ? pressure - 2.0*(pressure - 1.0)*k/(candidates - 1) : 1.0;
+        sum += weight;
+        cumulative[k] = sum;
+    }
+}
+
+unsigned int RankSelection::select() {
+    const double r = uniform.random(cumulative.back());
+    const unsigned int k = std::upper_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin();
+    return from + std::min(k, (unsigned int) cumulative.size() - 1);
+}
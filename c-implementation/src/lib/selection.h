@@ -0,0 +1,71 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <vector>
+#include <algorithm>
+#include "chromosome.h"
+
+enum class SELECTION {ROULETTE, TOURNAMENT, RANK};
+
+class Selection { // Abstract class that models a parent selection strategy
+    public:
+        virtual ~Selection() = default;
+        virtual std::string getName() const = 0;
+
+        // Called once per generation, with the fitness values sorted from best to worst. 
+        // Only the individuals in [from, fitness.size()) can be selected
+        virtual void prepare(const std::vector<double> &fitness, unsigned int from) = 0;
+        void prepare(const std::vector<Chromosome*> &population, unsigned int from); // Population sorted from best to worst
+        virtual unsigned int select() = 0; // Returns the index of the selected individual
+
+    protected:
+        Selection() = default;
+        static LocalUniform uniform;
+
+    private:
+        std::vector<double> values; // Fitness of the population
+};
+
+class RouletteSelection final : public Selection { // Probability proportional to the (shifted) fitness
+    public:
+        std::string getName() const override { return "Roulette"; }
+        using Selection::prepare;
+        void prepare(const std::vector<double> &fitness, unsigned int from) override;
+        unsigned int select() override;
+
+    private:
+        unsigned int from;
+        std::vector<double> cumulative; // Prefix sums of the scaled fitness, searched in O(log N)
+};
+
+class TournamentSelection final : public Selection { // Best of k individuals taken at random
+    public:
+        TournamentSelection(unsigned int size) : size(size) {}
+        inline void setSize(unsigned int size) { this->size = size; }
+        std::string getName() const override { return "Tournament"; }
+        using Selection::prepare;
+        void prepare(const std::vector<double> &fitness, unsigned int from) override;
+        unsigned int select() override;
+
+    private:
+        unsigned int size;
+        unsigned int from;
+        unsigned int to;
+};
+
+class RankSelection final : public Selection { // Linear distribution of probabilities based on ranking
+    public:
+        RankSelection(double pressure) : pressure(pressure) {} // Pressure is the expected copies of the best (1 to 2)
+        inline void setPressure(double pressure) { this->pressure = pressure; }
+        std::string getName() const override { return "Rank"; }
+        using Selection::prepare;
+        void prepare(const std::vector<double> &fitness, unsigned int from) override;
+        unsigned int select() override;
+
+    private:
+        double pressure;
+        unsigned int from;
+        std::vector<double> cumulative; // Only depends on the number of candidates
+};
+
+#endif // SELECTION_H
@@ -0,0 +1,29 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Helpers to write genotypes and messages as raw bytes. Values use the byte order of 
+// the machine, so the data is only exchanged between processes of the same host
+
+template<typename T>
+inline void serializeValue(std::vector<uint8_t> &buffer, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be serialized");
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+inline bool deserializeValue(const uint8_t *&data, const uint8_t *end, T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be serialized");
+    if(end - data < (long int) sizeof(T))
+        return false;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+#endif // SERIALIZATION_H
@@ -0,0 +1,126 @@
+#include "solver_pool.h"
+
+SolverPool::SolverPool(unsigned int threads) : nextId(0), queued(0), pending(0), stop(false) {
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < threads; i++)
+        queues.push_back(new Queue());
+    for (unsigned int i = 0; i < threads; i++)
+        workers.emplace_back(&SolverPool::workerLoop, this, i);
+}
+
+SolverPool::~SolverPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    available.notify_all();
+    for(std::thread &worker : workers)
+        worker.join();
+    for(SolverResult &result : finished){
+        delete result.results.best;
+        delete result.fitnessFunction;
+    }
+    for(Queue *queue : queues)
+        delete queue;
+}
+
+uint64_t SolverPool::submit(Fitness *fitnessFunction, GAConfig *config) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = nextId++;
+        pending++;
+    }
+    // Jobs are spread over the queues, idle workers steal them from the busy ones
+    Queue *queue = queues[id % queues.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.push_back({id, fitnessFunction, config});
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+    available.notify_one();
+    return id;
+}
+
+bool SolverPool::take(unsigned int index, Job &job) {
+    const unsigned int n = queues.size();
+    for (unsigned int k = 0; k < n; k++) {
+        Queue *queue = queues[(index + k) % n];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if(queue->jobs.empty())
+            continue;
+        if(k == 0){
+            job = queue->jobs.front();
+            queue->jobs.pop_front();
+        }else{
+            job = queue->jobs.back();
+            queue->jobs.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+void SolverPool::workerLoop(unsigned int index) {
+    // The algorithm of the worker is reused by all its jobs, so its evaluation workers and,
+    // when the fitness function can regenerate them, its chromosomes are not allocated again
+    GeneticAlgorithm *ga = nullptr; // Created with the first job
+    Job job;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]{ return stop || queued > 0; });
+            if(queued == 0) // Stopped and every job is done
+                break;
+            queued--; // A job is reserved, so it is found in one of the queues
+        }
+        while(!take(index, job))
+            std::this_thread::yield(); // The job is still being pushed
+
+        if(ga == nullptr)
+            ga = new GeneticAlgorithm(job.fitnessFunction, job.config);
+        else
+            ga->reset(job.fitnessFunction, job.config);
+        SolverResult result;
+        result.id = job.id;
+        result.results = ga->run();
+        if(result.results.best != nullptr){ // The best chromosome of the algorithm is replaced by the next job
+            Chromosome *best = job.fitnessFunction->generateChromosome();
+            best->clone(result.results.best);
+            result.results.best = best;
+        }
+        result.fitnessFunction = ga->releaseFitness(); // Not deleted by the next reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(result);
+        }
+        completed.notify_one();
+    }
+    if(ga != nullptr)
+        delete ga;
+}
+
+bool SolverPool::next(SolverResult &result) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(pending == 0)
+        return false;
+    completed.wait(lock, [this]{ return !finished.empty(); });
+    result = finished.front();
+    finished.pop_front();
+    pending--;
+    return true;
+}
+
+bool SolverPool::tryNext(SolverResult &result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(finished.empty())
+        return false;
+    result = finished.front();
+    finished.pop_front();
+    pending--;
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef SOLVER_POOL_H
+#define SOLVER_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "ga.h"
+
+struct SolverResult { // Finished job of a SolverPool
+    uint64_t id; // Returned by SolverPool::submit()
+    GAResults results; // results.best is a copy owned by the caller
+    // Fitness function of the job, owned by the caller as results.best may use its state. Delete it after results.best
+    Fitness *fitnessFunction;
+    SolverResult() : id(0), results(OBJTYPE::SINGLE), fitnessFunction(nullptr) {}
+};
+
+class SolverPool { // Solves many independent single-objective problems over a fixed set of worker threads
+    public:
+        SolverPool(unsigned int threads); // 0 uses all the available cores
+        ~SolverPool(); // Finishes the submitted jobs, the results not taken are released
+
+        // Queues a problem. The fitness function is returned with the result, the configuration must be valid
+        // until the result of the job is taken. Each job runs in one worker, so config->threads should be 1.
+        // Consecutive jobs of a worker with the same fitness class and population size reuse its chromosomes
+        // if the fitness function implements Fitness::regenerateChromosome()
+        uint64_t submit(Fitness *fitnessFunction, GAConfig *config);
+
+        bool next(SolverResult &result); // Waits for the next finished job (completion order). False if there are no jobs left
+        bool tryNext(SolverResult &result); // Same, without waiting
+
+        inline unsigned int size() const { return workers.size(); }
+
+    private:
+        struct Job {
+            uint64_t id;
+            Fitness *fitnessFunction;
+            GAConfig *config;
+        };
+
+        struct Queue { // Jobs of a worker. The owner takes the oldest ones, thieves the newest
+            std::deque<Job> jobs;
+            std::mutex mutex;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<Queue*> queues;
+        std::deque<SolverResult> finished;
+
+        std::mutex mutex;
+        std::condition_variable available; // New jobs for the workers
+        std::condition_variable completed; // New results for the caller
+        uint64_t nextId;
+        unsigned int queued; // Jobs in the queues not reserved by a worker
+        unsigned int pending; // Jobs submitted and not taken by next()
+        bool stop;
+
+        void workerLoop(unsigned int index);
+        bool take(unsigned int index, Job &job); // From the own queue, or stolen from another one
+};
+
+#endif // SOLVER_POOL_H
@@ -0,0 +1,33 @@
+#include "stop_conditions.h"
+#include <algorithm>
+
+void StopConditions::clear() {
+    deadline = std::chrono::high_resolution_clock::time_point::max();
+    interrupted = false;
+}
+
+void StopConditions::start(std::chrono::high_resolution_clock::time_point startTime, double timeout) {
+    timeout = std::min(std::max(timeout, 0.0), 1e9); // Longer times would overflow the clock
+    deadline = startTime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(timeout));
+    interrupted = false;
+}
+
+bool StopConditions::expired() const {
+    return (cancellation != nullptr && cancellation->isCancelled()) || std::chrono::high_resolution_clock::now() >= deadline;
+}
+
+STATUS StopConditions::check(const GAConfig *config, unsigned int &generation, unsigned int stagnatedGenerations) const {
+    if (cancellation != nullptr && cancellation->isCancelled())
+        return STATUS::CANCELLED;
+    if (interrupted || std::chrono::high_resolution_clock::now() >= deadline)
+        return STATUS::TIMEOUT;
+
+    const unsigned int maxStagnationGenerations = config->stagnationWindow*config->maxGenerations;
+    if(stagnatedGenerations > maxStagnationGenerations)
+        return STATUS::STAGNATED;
+
+    generation++;
+    if(generation >= config->maxGenerations)
+        return STATUS::MAX_GENERATIONS;
+    return STATUS::RUNNING;
+}
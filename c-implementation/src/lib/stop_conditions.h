@@ -0,0 +1,42 @@
+#ifndef STOP_CONDITIONS_H
+#define STOP_CONDITIONS_H
+
+#include <atomic>
+#include <chrono>
+
+#include "ga_config.h"
+#include "ga_results.h"
+#include "cancellation.h"
+
+#define DEADLINE_CHECK 8 // Individuals evaluated by a worker between checks of the deadline
+
+class StopConditions { // Deadline, cancellation and stop conditions of a run, used by GeneticAlgorithm and GeneticAlgorithmT
+    public:
+        StopConditions() : cancellation(nullptr), deadline(std::chrono::high_resolution_clock::time_point::max()), interrupted(false) {}
+
+        void clear(); // No deadline until the run starts
+        void start(std::chrono::high_resolution_clock::time_point startTime, double timeout); // Deadline after timeout seconds
+        inline void setCancellationToken(CancellationToken *token) { cancellation = token; }
+
+        bool expired() const; // Deadline passed or run cancelled
+        inline bool expired(unsigned int k) { // Checked by the workers, reading the clock every DEADLINE_CHECK individuals
+            if(interrupted.load(std::memory_order_relaxed))
+                return true;
+            if(k % DEADLINE_CHECK == 0 && expired()){
+                interrupted.store(true, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+        inline bool isInterrupted() const { return interrupted.load(std::memory_order_relaxed); } // An evaluation was stopped
+
+        // Status at the end of a generation, the generation counter is advanced if the run continues
+        STATUS check(const GAConfig *config, unsigned int &generation, unsigned int stagnatedGenerations) const;
+
+    private:
+        CancellationToken *cancellation;
+        std::chrono::high_resolution_clock::time_point deadline; // Start time plus the timeout
+        std::atomic<bool> interrupted; // The evaluation was stopped by the deadline or the token
+};
+
+#endif // STOP_CONDITIONS_H
@@ -0,0 +1,82 @@
+#include "telemetry.h"
+
+#include <iostream>
+#include <chrono>
+
+#define TELEMETRY_MAGIC 0x544E4144 // "DNAT"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_PERIOD 50 // Milliseconds between writes
+
+Telemetry::Telemetry(const std::string &path, bool binary) : path(path), binary(binary), head(0), tail(0), dropped(0), stop(false) {
+    file.open(path, binary ? std::ios::binary : std::ios::out);
+    if(!file.is_open()){
+        std::cerr << "Telemetry: cannot write " << path << std::endl;
+        return;
+    }
+    if(binary){
+        const uint32_t header[3] = {TELEMETRY_MAGIC, TELEMETRY_VERSION, sizeof(GenerationStats)};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }else{
+        file << "generation,elapsed,best,mean,deviation,diversity,front,evaluations" << std::endl;
+    }
+    writer = std::thread(&Telemetry::writerLoop, this);
+}
+
+Telemetry::~Telemetry() {
+    close();
+}
+
+void Telemetry::record(const GenerationStats &stats) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    if(t - head.load(std::memory_order_acquire) == TELEMETRY_CAPACITY){
+        dropped++;
+        return;
+    }
+    records[t & (TELEMETRY_CAPACITY - 1)] = stats;
+    tail.store(t + 1, std::memory_order_release);
+}
+
+void Telemetry::close() {
+    if(!writer.joinable())
+        return;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    writer.join();
+    file.close();
+    if(dropped > 0)
+        std::cerr << "Telemetry: " << dropped << " records dropped in " << path << std::endl;
+}
+
+void Telemetry::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        // The algorithm does not notify new records, they are written periodically
+        wake.wait_for(lock, std::chrono::milliseconds(TELEMETRY_PERIOD), [this]{ return stop; });
+        const bool last = stop; // Records queued before close() are written
+        lock.unlock();
+        drain();
+        lock.lock();
+        if(last)
+            break;
+    }
+}
+
+void Telemetry::drain() {
+    const uint32_t t = tail.load(std::memory_order_acquire);
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if(h == t)
+        return;
+    for(; h != t; h++){
+        const GenerationStats &stats = records[h & (TELEMETRY_CAPACITY - 1)];
+        if(binary)
+            file.write(reinterpret_cast<const char*>(&stats), sizeof(stats));
+        else
+            file << stats.generation << "," << stats.elapsed << "," << stats.best << "," << stats.mean << ","
+                << stats.deviation << "," << stats.diversity << "," << stats.frontSize << "," << stats.evaluations << "\n";
+        head.store(h + 1, std::memory_order_release); // Slot can be reused
+    }
+    file.flush(); // Records can be read while the run continues
+}
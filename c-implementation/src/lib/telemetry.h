@@ -0,0 +1,54 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#define TELEMETRY_CAPACITY 4096 // Records waiting to be written (power of 2)
+
+struct GenerationStats { // One record per generation
+    uint32_t generation;
+    uint32_t frontSize; // Individuals in the first front (multi-objective runs, 0 otherwise)
+    double elapsed; // Milliseconds since the start of the run
+    double best; // Highest fitness, or lowest first objective in multi-objective runs
+    double mean;
+    double deviation;
+    double diversity; // Fraction of distinct genotypes in the population
+    uint64_t evaluations;
+};
+
+class Telemetry { // Writes the generation records from a background thread, as CSV or binary
+    public:
+        // Opens the file and starts the writer thread. Binary files have a header (magic, version,
+        // record size) followed by the records
+        Telemetry(const std::string &path, bool binary);
+        ~Telemetry(); // Same as close()
+
+        // Called from the thread of the algorithm, it never waits for the writer. Records that do
+        // not fit in the queue are dropped
+        void record(const GenerationStats &stats);
+        void close(); // Writes the queued records and closes the file
+
+    private:
+        std::string path;
+        bool binary;
+        std::ofstream file;
+        GenerationStats records[TELEMETRY_CAPACITY];
+        std::atomic<uint32_t> head; // Records written, only updated by the writer
+        std::atomic<uint32_t> tail; // Records queued, only updated by record()
+        unsigned long dropped;
+        std::thread writer;
+        std::mutex mutex; // Only used to wake up the writer when closing
+        std::condition_variable wake;
+        bool stop;
+
+        void writerLoop();
+        void drain();
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,107 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned int threads) : epoch(0), active(0), stop(false), invoke(nullptr), context(nullptr) {
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    ranges = std::vector<std::atomic<uint64_t>>(threads);
+    for(unsigned int i = 0; i < threads; i++)
+        ranges[i].store(0);
+
+    // The calling thread takes part in every loop, so only threads-1 workers are created
+    for(unsigned int i = 1; i < threads; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for(std::thread &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::run(unsigned int count, Invoker invoke, void *context) {
+    if(count == 0)
+        return;
+
+    if(workers.empty() || count == 1){ // Nothing to share
+        for(unsigned int i = 0; i < count; i++)
+            invoke(context, i);
+        return;
+    }
+
+    const unsigned int threads = size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->invoke = invoke;
+        this->context = context;
+        for(unsigned int t = 0; t < threads; t++){
+            const uint32_t begin = (uint64_t) count * t / threads;
+            const uint32_t end = (uint64_t) count * (t + 1) / threads;
+            ranges[t].store(pack(begin, end));
+        }
+        active = workers.size();
+        epoch++;
+    }
+    wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]{ return active == 0; });
+}
+
+void ThreadPool::workerLoop(unsigned int index) {
+    unsigned long seen = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen]{ return stop || epoch != seen; });
+            if(stop)
+                return;
+            seen = epoch;
+        }
+
+        work(index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        active--;
+        if(active == 0)
+            done.notify_one();
+    }
+}
+
+void ThreadPool::work(unsigned int index) {
+    do {
+        // Take indices one at a time from the front of the own block
+        uint64_t range = ranges[index].load();
+        while(first(range) < last(range)){
+            const uint32_t i = first(range);
+            if(ranges[index].compare_exchange_weak(range, pack(i + 1, last(range))))
+                invoke(context, i);
+            else
+                continue; // range was reloaded by the failed exchange
+            range = ranges[index].load();
+        }
+    } while(steal(index));
+}
+
+bool ThreadPool::steal(unsigned int index) {
+    // Take the upper half of the first non empty block of another thread
+    const unsigned int threads = size();
+    for(unsigned int k = 1; k < threads; k++){
+        const unsigned int victim = (index + k) % threads;
+        uint64_t range = ranges[victim].load();
+        while(first(range) < last(range)){
+            const uint32_t middle = first(range) + (last(range) - first(range)) / 2;
+            if(ranges[victim].compare_exchange_weak(range, pack(first(range), middle))){
+                ranges[index].store(pack(middle, last(range)));
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,58 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+class ThreadPool { // Fixed set of worker threads that share loops by work-stealing
+    public:
+        ThreadPool(unsigned int threads); // 0 uses all the available cores
+        ~ThreadPool();
+
+        // Number of threads taking part in a loop (workers plus the calling thread)
+        inline unsigned int size() const { return workers.size() + 1; }
+
+        // Calls body(i) for every i in [0, count) and returns when all calls are done.
+        // Each thread starts with a contiguous block of indices and, once its block is
+        // exhausted, steals half of the remaining block of another thread.
+        template<typename Body>
+        void parallelFor(unsigned int count, Body &&body) {
+            typedef typename std::remove_reference<Body>::type BodyType;
+            run(count, [](void *context, unsigned int i) {
+                (*static_cast<BodyType*>(context))(i);
+            }, (void*) &body);
+        }
+
+    private:
+        typedef void (*Invoker)(void *context, unsigned int i);
+
+        std::vector<std::thread> workers;
+        std::vector<std::atomic<uint64_t>> ranges; // Remaining [begin, end) block of each thread
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        unsigned long epoch; // Incremented every time a new loop is published
+        unsigned int active; // Workers still working on the current loop
+        bool stop;
+
+        Invoker invoke;
+        void *context;
+
+        void run(unsigned int count, Invoker invoke, void *context);
+        void workerLoop(unsigned int index);
+        void work(unsigned int index);
+        bool steal(unsigned int index);
+
+        static inline uint64_t pack(uint32_t begin, uint32_t end) { return ((uint64_t) begin << 32) | end; }
+        static inline uint32_t first(uint64_t range) { return (uint32_t) (range >> 32); }
+        static inline uint32_t last(uint64_t range) { return (uint32_t) range; }
+};
+
+#endif // THREAD_POOL_H
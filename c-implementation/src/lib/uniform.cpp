@@ -1,22 +1,88 @@
 #include "uniform.h"
+#include <random>
+
+static uint64_t splitmix64(uint64_t &x) { // Used to expand a seed into the generator state
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t randomSeed() { // Only used when the user does not provide a seed
+    std::random_device rd;
+    return ((uint64_t) rd() << 32) | (uint64_t) rd();
+}
+
+std::atomic<uint64_t> Uniform::masterSeed(randomSeed());
+std::atomic<uint64_t> Uniform::nextStream(1); // Stream 0 belongs to the thread that sets the seed
 
 Uniform::Uniform() {
-    gen = std::mt19937(rd());
-    dis = std::uniform_real_distribution<>(0.0, 1.0);
+    seed(masterSeed, nextStream++);
+}
+
+Uniform::Uniform(uint64_t seed, uint64_t stream) {
+    this->seed(seed, stream);
 }
 
 Uniform::~Uniform() {}
 
-double Uniform::random() {
-    return dis(gen);
+void Uniform::seed(uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ splitmix64(stream);
+    for (int i = 0; i < 4; i++)
+        state[i] = splitmix64(x);
+}
+
+void Uniform::getState(uint64_t state[4]) const {
+    for (int i = 0; i < 4; i++)
+        state[i] = this->state[i];
+}
+
+void Uniform::setState(const uint64_t state[4]) {
+    for (int i = 0; i < 4; i++)
+        this->state[i] = state[i];
+}
+
+void Uniform::setSeed(uint64_t seed) {
+    masterSeed = seed;
+    nextStream = 1;
+    local().seed(seed, 0);
+}
+
+uint64_t Uniform::getSeed() {
+    return masterSeed;
+}
+
+Uniform& Uniform::local() {
+    static thread_local Uniform generator;
+    return generator;
+}
+
+uint64_t Uniform::bits() {
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+}
+
+double Uniform::random() { // Uniform in [0, 1) using the 53 upper bits
+    return (double) (bits() >> 11) * 0x1.0p-53;
 }
 
 double Uniform::random(double to) {
-    double value = dis(gen) * to;
+    double value = random() * to;
     return value;
 }
 
 double Uniform::random(double from, double to) {
-    double value = from + dis(gen) * (to - from);
+    double value = from + random() * (to - from);
     return value;
-}
\ No newline at end of file
+}
@@ -1,21 +1,40 @@
 #ifndef UNIFORM_H
 #define UNIFORM_H
 
-#include <random>
+#include <cstdint>
+#include <atomic>
 
-class Uniform {
+class Uniform { // xoshiro256** generator. Streams are derived from a single master seed
     public:
-        Uniform();
+        Uniform(); // Takes the next unused stream of the master seed
+        Uniform(uint64_t seed, uint64_t stream);
         ~Uniform();
         double random();
         double random(double to);
         double random(double from, double to);
+        uint64_t bits(); // 64 random bits
+
+        void seed(uint64_t seed, uint64_t stream);
+        void getState(uint64_t state[4]) const; // Used to save and restore the stream (checkpoints)
+        void setState(const uint64_t state[4]);
+
+        static void setSeed(uint64_t seed); // Restarts the streams, including the one of the calling thread
+        static uint64_t getSeed();
+        static Uniform& local(); // Stream of the calling thread
 
     private:
-        std::random_device rd;
-        std::mt19937 gen;
-        std::uniform_real_distribution<> dis;
+        uint64_t state[4];
+
+        static std::atomic<uint64_t> masterSeed; // Runs of a SolverPool set it from several threads
+        static std::atomic<uint64_t> nextStream;
 };
 
+class LocalUniform { // Stateless handle that draws from the stream of the calling thread
+    public:
+        inline double random() { return Uniform::local().random(); }
+        inline double random(double to) { return Uniform::local().random(to); }
+        inline double random(double from, double to) { return Uniform::local().random(from, to); }
+        inline uint64_t bits() { return Uniform::local().bits(); }
+};
 
-#endif // UNIFORM_H
\ No newline at end of file
+#endif // UNIFORM_H